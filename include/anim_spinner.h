@@ -0,0 +1,41 @@
+// Generated by tools/animc.py from spinner.pgm -- do not edit
+// 32x32, 12 frames + loop, 437 bytes (raw 1536)
+#ifndef _ANIM_ANIM_SPINNER_H
+#define _ANIM_ANIM_SPINNER_H
+
+static const uint8_t anim_spinner_data[] = {
+    0x0F, 0x01, 0x00, 0x1F, 0xF1, 0x00, 0xFE, 0x7E, 0x00, 0xFE, 0xFE, 0xFC, 0x04, 0xF8, 0xF0, 0xF0,
+    0xE0, 0xC0, 0xFD, 0x00, 0x00, 0x1F, 0xF4, 0x00, 0x00, 0xC0, 0xFD, 0xE0, 0x06, 0xC0, 0x00, 0x00,
+    0x01, 0x03, 0x07, 0x1F, 0xFD, 0xFF, 0x02, 0xFE, 0xF0, 0x00, 0x00, 0x1F, 0xF4, 0x00, 0x00, 0x03,
+    0xFD, 0x07, 0x06, 0x03, 0x00, 0x00, 0x80, 0xC0, 0xE0, 0xF8, 0xFD, 0xFF, 0x02, 0x7F, 0x0F, 0x00,
+    0x00, 0x1F, 0xEF, 0x00, 0x01, 0x0E, 0x7F, 0xFE, 0x3F, 0x04, 0x1F, 0x0F, 0x0F, 0x07, 0x03, 0xFD,
+    0x00, 0x09, 0x00, 0x10, 0x16, 0xFE, 0x7E, 0x03, 0xFE, 0xFC, 0x3C, 0x1C, 0x0C, 0x12, 0x00, 0x78,
+    0xFC, 0x7E, 0x00, 0x70, 0x0F, 0x00, 0x15, 0x1B, 0x06, 0xC0, 0xE0, 0xF8, 0xF0, 0xF0, 0xE0, 0xC0,
+    0x15, 0x1C, 0x01, 0x01, 0x03, 0xFE, 0x07, 0x02, 0x03, 0x01, 0x01, 0x08, 0x0A, 0x02, 0x80, 0xC0,
+    0x80, 0x05, 0x0C, 0x03, 0x06, 0x0F, 0x0F, 0x1F, 0xFE, 0x3F, 0x00, 0x07, 0x0E, 0x00, 0x18, 0x1E,
+    0x02, 0x18, 0xF8, 0xFC, 0xFE, 0xFE, 0x00, 0xF0, 0x01, 0x08, 0x02, 0x08, 0x78, 0xF8, 0xFE, 0xFC,
+    0x01, 0xF8, 0x60, 0x04, 0x05, 0x01, 0x03, 0x01, 0x06, 0x00, 0x01, 0x06, 0xFD, 0xF0, 0xFF, 0xE0,
+    0x01, 0x1E, 0xFE, 0x07, 0xFE, 0x03, 0xF0, 0x00, 0x02, 0x18, 0x1F, 0x3F, 0xFE, 0x7F, 0x00, 0x0F,
+    0x0F, 0x00, 0x04, 0x07, 0x03, 0xC0, 0xE0, 0xE0, 0xC0, 0x02, 0x09, 0x02, 0x0E, 0x0F, 0x0F, 0xFE,
+    0x1F, 0x01, 0x07, 0x02, 0x15, 0x1C, 0x01, 0x80, 0xC0, 0xFE, 0xE0, 0x02, 0xC0, 0x80, 0x80, 0x15,
+    0x1B, 0x06, 0x03, 0x07, 0x1F, 0x0F, 0x0F, 0x07, 0x03, 0x0B, 0x00, 0x06, 0x0D, 0x02, 0x10, 0x30,
+    0xF8, 0xFE, 0xFC, 0x01, 0xFE, 0x70, 0x09, 0x0A, 0xFF, 0x01, 0x10, 0x16, 0xFE, 0x7E, 0x03, 0x7F,
+    0x3F, 0x3C, 0x38, 0x09, 0x00, 0x0D, 0x13, 0x00, 0x0E, 0xFC, 0x7E, 0x00, 0x1E, 0x09, 0x0F, 0x03,
+    0x38, 0x3C, 0x3F, 0x7F, 0xFE, 0x7E, 0x0F, 0x00, 0x13, 0x1A, 0x00, 0xE0, 0xFE, 0xFC, 0x03, 0xF8,
+    0xF0, 0xF0, 0x60, 0x15, 0x17, 0x02, 0x01, 0x03, 0x01, 0x03, 0x0A, 0xFF, 0x80, 0x00, 0xC0, 0xFE,
+    0xE0, 0x01, 0xC0, 0x80, 0x04, 0x0A, 0x06, 0x03, 0x07, 0x0F, 0x0F, 0x1F, 0x07, 0x03, 0x07, 0x00,
+    0x1A, 0x1B, 0x01, 0x80, 0xC0, 0x17, 0x1E, 0x01, 0x06, 0x1F, 0xFE, 0x3F, 0x02, 0x1F, 0x1E, 0x10,
+    0x01, 0x07, 0x00, 0x0F, 0xFE, 0x7F, 0x02, 0x3F, 0x1F, 0x18, 0x06, 0x00, 0x01, 0x1E, 0x00, 0xF0,
+    0xFE, 0xFE, 0x02, 0xFC, 0xF8, 0x18, 0xF0, 0x00, 0xFE, 0xC0, 0xFE, 0xE0, 0x19, 0x1E, 0xFF, 0x07,
+    0xFD, 0x0F, 0x0F, 0x00, 0x04, 0x0A, 0x06, 0xC0, 0xE0, 0xF0, 0xF0, 0xF8, 0xE0, 0xC0, 0x03, 0x0A,
+    0xFF, 0x01, 0x00, 0x03, 0xFE, 0x07, 0x01, 0x03, 0x01, 0x16, 0x1D, 0x01, 0x40, 0xE0, 0xFE, 0xF8,
+    0xFF, 0xF0, 0x00, 0x70, 0x18, 0x1B, 0x03, 0x03, 0x07, 0x07, 0x03, 0x0D, 0x00, 0x09, 0x0F, 0x03,
+    0x1C, 0x3C, 0xFC, 0xFE, 0xFE, 0x7E, 0x15, 0x16, 0xFF, 0x80, 0x12, 0x19, 0x01, 0x0E, 0x7F, 0xFE,
+    0x3F, 0x02, 0x1F, 0x0C, 0x08,
+};
+
+static const SSD1306_Animation anim_spinner = {
+    anim_spinner_data, 437, 81, 13, 42, 32, 32, // data, size, loop_offset, frame_count, frame_interval, width, height
+};
+
+#endif
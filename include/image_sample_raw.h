@@ -0,0 +1,45 @@
+// Generated by tools/imgc.py from sample.pgm -- do not edit
+// 64x64, Floyd-Steinberg, 512 bytes raw, 368 bytes RLE (71%)
+#ifndef _IMAGE_IMAGE_SAMPLE_RAW_H
+#define _IMAGE_IMAGE_SAMPLE_RAW_H
+
+static const uint8_t image_sample_raw_data[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x80, 0x80, 0xC0, 0xC0, 0xC0, 0xA0, 0xE0, 0xE0, 0xE0, 0x70, 0xD0, 0xF0, 0xD0, 0xF0,
+    0x60, 0xD0, 0xF0, 0xA0, 0xF0, 0x40, 0xE0, 0x40, 0xA0, 0x40, 0x80, 0x40, 0x80, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xD8, 0xFC, 0xFE,
+    0xFA, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF, 0xFF, 0xFB, 0xBF, 0xFF, 0xFD,
+    0xBF, 0xF7, 0xFE, 0xBB, 0xEF, 0xFD, 0xBF, 0xD5, 0x7F, 0xD5, 0xAA, 0xFF, 0x54, 0xAB, 0x74, 0x8A,
+    0x74, 0x88, 0x60, 0x90, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x70, 0xDC, 0xF6, 0xFF, 0xBB, 0xFF, 0xFF, 0xFF, 0xEF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xBF, 0xFF, 0xFF, 0xFF, 0xDF, 0xFF, 0xFE, 0x7F, 0xFF, 0xF7, 0x7F, 0xFF, 0xDD,
+    0xFF, 0x77, 0xDE, 0xFB, 0xAF, 0x7E, 0xF7, 0x5D, 0xAB, 0xFE, 0xAB, 0x76, 0x9B, 0xED, 0x32, 0xCF,
+    0x30, 0xCF, 0x30, 0x46, 0xA9, 0x14, 0x80, 0x28, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xE8, 0x57, 0xFD, 0xBF, 0xD6, 0xFF, 0x7B, 0xFF, 0xDF, 0x7B, 0xFF, 0xDF,
+    0xFD, 0xFF, 0x6F, 0xFF, 0xFB, 0x7F, 0xDF, 0xFB, 0x7F, 0xDF, 0xFB, 0x6F, 0xFF, 0x5B, 0xFF, 0xAD,
+    0xFF, 0xD5, 0x7F, 0xAA, 0xDF, 0xFB, 0x17, 0xED, 0xBA, 0x57, 0xEA, 0x1D, 0xE2, 0x1F, 0xE0, 0x1F,
+    0xA0, 0x4F, 0x30, 0x85, 0x52, 0x08, 0x42, 0x08, 0x00, 0x02, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x12, 0xAF, 0x75, 0x9A, 0x6F, 0xDB, 0x7D, 0xD7, 0xBF, 0x55, 0xFF, 0xAA,
+    0xDF, 0x7F, 0xD5, 0x7F, 0xAB, 0xDD, 0xFF, 0x57, 0xBD, 0xD7, 0x7D, 0xD7, 0x2D, 0xF7, 0x5D, 0xAA,
+    0x77, 0xDA, 0x27, 0xDB, 0x2C, 0xF3, 0x0D, 0xFA, 0x05, 0x7A, 0x85, 0x6A, 0x15, 0x4A, 0x25, 0x10,
+    0x8A, 0x25, 0x80, 0x0A, 0x20, 0x05, 0x80, 0x10, 0x01, 0x40, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x09, 0x06, 0x53, 0x2C, 0x93, 0x6E, 0x15, 0xEB, 0x14, 0xEB,
+    0x1E, 0xE3, 0x1D, 0xE7, 0x18, 0xEF, 0x12, 0xED, 0x17, 0xE8, 0x17, 0x6D, 0x92, 0x2D, 0xD2, 0x2F,
+    0x50, 0x0F, 0xA0, 0x5F, 0x00, 0xAB, 0x14, 0x42, 0x29, 0x12, 0x48, 0x03, 0x14, 0x41, 0x00, 0x85,
+    0x10, 0x00, 0x80, 0x10, 0x02, 0x80, 0x08, 0x00, 0x22, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x04, 0x02, 0x11, 0x04,
+    0x02, 0x29, 0x02, 0x24, 0x0B, 0x10, 0x46, 0x11, 0x04, 0x22, 0x09, 0x12, 0x04, 0x21, 0x0A, 0x80,
+    0x15, 0x02, 0x20, 0x01, 0x08, 0x82, 0x10, 0x01, 0x80, 0x12, 0x00, 0x80, 0x12, 0x00, 0x20, 0x04,
+    0x00, 0x20, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x04, 0x00, 0x00, 0x04,
+    0x00, 0x08, 0x01, 0x00, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const SSD1306_Image image_sample_raw = {
+    image_sample_raw_data, 512, 64, 64, SSD1306_IMAGE_RAW, // data, size, width, height, encoding
+};
+
+#endif
@@ -6,12 +6,83 @@
 
 #define SSD1306_BUFFER_SIZE (SSD1306_WIDTH * SSD1306_HEIGHT / 8) // 1024 bytes for 128x64 OLED
 
+// Internal frame buffer layout: one control byte slot in front of each page row, so a page goes out in one packet
+#define SSD1306_PAGE_STRIDE (SSD1306_WIDTH + 1)
+#define SSD1306_FRAME_SIZE (SSD1306_PAGE_STRIDE * SSD1306_HEIGHT / 8) // 1032 bytes for 128x64 OLED
+
 #define SSD1306_WRITE 0x00
 #define SSD1306_READ 0x01
 
 #define SSD1306_MODE_COMMAND 0x00 // Command mode
 #define SSD1306_MODE_DATA 0x40    // Data mode
 
+#define SSD1306_UTF8_REPLACEMENT 0xFFFD // Code point returned for malformed UTF-8 sequences
+
+// Text box layout flags for SSD1306_DrawTextBox()
+#define SSD1306_TEXT_ALIGN_LEFT 0x00
+#define SSD1306_TEXT_ALIGN_CENTER 0x01
+#define SSD1306_TEXT_ALIGN_RIGHT 0x02
+#define SSD1306_TEXT_ALIGN_MASK 0x03
+#define SSD1306_TEXT_WRAP 0x04     // Word wrap at spaces (long words are broken)
+#define SSD1306_TEXT_ELLIPSIS 0x08 // Truncate overflowing text with "..."
+
+// Integer angle units for the polar drawing API: 0 = 12 o'clock, clockwise, 0.1 degree per unit
+#define SSD1306_ANGLE_FULL 3600
+
+// Bitmap source formats for SSD1306_DrawBitmapEx()
+#define SSD1306_BITMAP_PAGE_MAJOR 0x00 // Same layout as the frame buffer: width bytes per 8-row page, LSB at top
+#define SSD1306_BITMAP_ROW_MAJOR 0x01  // XBM: (width + 7) / 8 bytes per row, LSB at left
+
+// Image data encodings (SSD1306_Image.encoding, written by tools/imgc.py)
+#define SSD1306_IMAGE_RAW 0x00 // Page-major bytes as is
+#define SSD1306_IMAGE_RLE 0x01 // PackBits run-length coded page-major bytes (decoded while blitting)
+
+// Back buffer contents after SSD1306_Acquire()
+#define SSD1306_PRESENT_PRESERVE 0x00 // The last presented frame (only the changed spans are copied)
+#define SSD1306_PRESENT_DISCARD 0x01  // Undefined (an older frame); redraw the whole screen
+
+// What SSD1306_StreamBitmap() / SSD1306_StreamImage() keep in step with the panel (0 = neither)
+#define SSD1306_STREAM_SHADOW 0x01 // Copy the sent bytes into the shadow so later updates diff against them
+#define SSD1306_STREAM_BUFFER 0x02 // Copy them into the drawing buffer too, so later updates keep the image
+
+// Budget units for SSD1306_UpdateStep(): bus bytes (9 clocks each on I2C)
+#define SSD1306_STEP_SPAN_OVERHEAD 12                                                  // Per span at most: window command (address, control, 8 bytes) + data write header
+#define SSD1306_STEP_BUDGET_US(us, bus_hz) ((uint32_t)(us) * ((bus_hz) / 1000) / 9000) // Bytes that fit in us microseconds
+
+// Largest box sent in vertical addressing mode (columns x pages); it is gathered into a buffer of this size
+#ifndef SSD1306_VERTICAL_MAX_BYTES
+#define SSD1306_VERTICAL_MAX_BYTES 128
+#endif
+
+// Wait in SSD1306_InitFast() before the first command (controller power-up); raise it for modules whose reset
+// circuit or supply needs longer. The panel itself needs no pause between the init sequence and display-on
+#ifndef SSD1306_INIT_DELAY_MS
+#define SSD1306_INIT_DELAY_MS 1
+#endif
+
+// Longest run of queued display setting commands (contrast 2 bytes, entire display, inverse, on/off)
+#define SSD1306_QUEUE_MAX_BYTES 5
+
+// Color values accepted by every color parameter (raster operation applied to the covered pixels)
+#define SSD1306_COLOR_BLACK 0x00  // Clear pixels
+#define SSD1306_COLOR_WHITE 0x01  // Set pixels
+#define SSD1306_COLOR_INVERT 0x04 // Toggle pixels, drawing the same shape again restores (= SSD1306_BLIT_XOR)
+
+// Fill patterns for SSD1306_SetFillPattern() (8x8, anchored to screen coordinates)
+#define SSD1306_PATTERN_SOLID 0x00
+#define SSD1306_PATTERN_25 0x01         // 25% dither
+#define SSD1306_PATTERN_50 0x02         // 50% dither (checkerboard)
+#define SSD1306_PATTERN_75 0x03         // 75% dither
+#define SSD1306_PATTERN_HATCH 0x04      // Diagonal hatch
+#define SSD1306_PATTERN_CROSSHATCH 0x05 // Diagonal cross hatch
+
+// Bitmap drawing modes (CLEAR/SET and XOR match the color values and leave 0 bits untouched)
+#define SSD1306_BLIT_CLEAR 0x00    // Clear pixels where the bitmap is 1
+#define SSD1306_BLIT_SET 0x01      // Set pixels where the bitmap is 1
+#define SSD1306_BLIT_OPAQUE 0x02   // Copy the bitmap, 0 bits clear the background
+#define SSD1306_BLIT_INVERTED 0x03 // Copy the inverted bitmap
+#define SSD1306_BLIT_XOR 0x04      // Toggle pixels where the bitmap is 1 (drawing twice restores)
+
 #define SSD1306_ADDRESS 0x3C // I2C address for SSD1306 SA0=0
 // #define SSD1306_ADDRESS 0x3D // I2C address for SSD1306 SA0=1
 
@@ -69,17 +140,98 @@
 #define SSD1306_CMD_SET_NOP 0xE3                        // No Operation Command
 
 /**
- * @brief スワップ用のダブルバッファを切り替える
- * @note 滑らかなアニメーションを実現するために使用
+ * @brief プロポーショナルフォントのグリフ情報
+ * @note ビットマップはページ優先（1ページ=縦8ピクセル、LSBが上）で (height + 7) / 8 ページ × width バイト
+ */
+typedef struct
+{
+    uint16_t codepoint; // Unicodeコードポイント
+    uint16_t offset;    // SSD1306_Font.bitmaps内のビットマップ開始位置
+    uint8_t width;      // ビットマップの幅（ピクセル）
+    uint8_t advance;    // 次の文字までの送り幅（ピクセル）
+} SSD1306_FontGlyph;
+
+/**
+ * @brief プロポーショナル・マルチサイズフォント
+ * @note tools/fontc.py でBDFフォントから生成する
+ */
+typedef struct
+{
+    const uint8_t *bitmaps;          // 全グリフのページ優先ビットマップ
+    const SSD1306_FontGlyph *glyphs; // コードポイント順に整列したグリフ表
+    uint16_t glyph_count;            // グリフ数
+    uint8_t height;                  // セルの高さ（ピクセル）
+    uint8_t baseline;                // セル上端からベースラインまでの距離
+    uint8_t line_height;             // 行送り（ピクセル）
+    uint8_t default_advance;         // フォントにない文字の送り幅
+} SSD1306_Font;
+
+/**
+ * @brief 画像アセット
+ * @note tools/imgc.py でPNG/PGM画像から生成する
+ */
+typedef struct
+{
+    const uint8_t *data; // ページ形式のビットマップ（encodingに従って符号化）
+    uint16_t size;       // dataのバイト数
+    uint8_t width;       // 幅（ピクセル）
+    uint8_t height;      // 高さ（ピクセル）
+    uint8_t encoding;    // SSD1306_IMAGE_RAW / SSD1306_IMAGE_RLE
+} SSD1306_Image;
+
+/**
+ * @brief 描画したフレームを表示してバックバッファを切り替える（SSD1306_Present() + SSD1306_Acquire(1)）
+ * @note 滑らかなアニメーションを実現するために使用。続けてSSD1306_Update()を呼び出す必要はない
  */
 void SSD1306_Buffer_swap(void);
 
+/**
+ * @brief ページフリップの動作を設定する
+ * @param mode SSD1306_PRESENT_PRESERVE / SSD1306_PRESENT_DISCARD
+ * @param third_buffer トリプルバッファリング用の3枚目のバッファ（SSD1306_FRAME_SIZEバイト、NULLでダブルバッファリング）
+ * @note 既定はダブルバッファリング・PRESERVE。3枚目のバッファがあると、前のフレームの転送中でも
+ *       SSD1306_Acquire()が待たずに戻る（未転送のフレームは新しいフレームで置き換えられる）
+ */
+void SSD1306_SetPresentMode(uint8_t mode, uint8_t *third_buffer);
+
+/**
+ * @brief 描画したバックバッファを表示に回す（転送の完了を待たない）
+ * @note 転送はSSD1306_IIC_Packet_Start_HAL()でパケットごとに開始され、SSD1306_Poll()で進む。
+ *       次の描画の前にSSD1306_Acquire()でバックバッファを取得すること
+ */
+void SSD1306_Present(void);
+
+/**
+ * @brief 次に描画するバックバッファを取得する
+ * @param wait 1=取得できるまで転送を進めながら待つ, 0=待たない
+ * @return 1=描画できる, 0=まだ使えるバッファがない（ダブルバッファリングで前のフレームを転送中）
+ * @note PRESERVEモードでは最後に表示に回したフレームとの差分だけをコピーしてから返す
+ */
+uint8_t SSD1306_Acquire(uint8_t wait);
+
+/**
+ * @brief 表示に回したフレームの転送を進める
+ * @note バスが空いている間、次のパケット（アドレス設定・列範囲のデータ）を開始する。
+ *       非同期転送のHALでは転送完了割り込みから呼び出すと、描画と転送が完全に並行する。
+ *       メインループと割り込みの両方から同時に呼び出さないこと
+ */
+void SSD1306_Poll(void);
+
 /**
  * @brief SSD1306 OLEDディスプレイを初期化する
  * @note I2C通信とディスプレイの基本設定を行う
  */
 void SSD1306_Init(void);
 
+/**
+ * @brief 起動時間を短縮した初期化（最初の表示までの時間を最小にする）
+ * @param splash 最初の表示で中央に表示する画像（NULLで空白）
+ * @note 設定コマンド全体を1回のトランザクションで送り、固定の100ms待ちの代わりにSSD1306_INIT_DELAY_MSだけ待つ。
+ *       表示がオフのままGDDRAM全体を書き込んでから表示をオンにするため、前回の内容や乱れた画面が見えない。
+ *       以降の動作はSSD1306_Init()と同じ
+ */
+void SSD1306_InitFast(const SSD1306_Image *splash);
+
 /**
  * @brief ディスプレイバッファをクリアする（全ピクセルを消去）
  */
@@ -96,8 +248,88 @@ void SSD1306_Update(void);
  */
 void SSD1306_Update_Full(void);
 
+/**
+ * @brief 変更箇所を転送し、転送したバッファを表示内容の控えとしてそのまま使う（ポインタの入れ替え）
+ * @note 転送した範囲を控えにコピーしないため、SSD1306_Update()より処理が少ない。
+ *       呼び出し後の描画バッファの内容は1つ前のフレームになるので、毎フレーム画面全体を描き直す場合に使う
+ */
+void SSD1306_Update_Swap(void);
+
+/**
+ * @brief 描画バッファ以外のフレーム（ページ形式、SSD1306_BUFFER_SIZEバイト）をディスプレイに転送する
+ * @param frame 転送するフレーム
+ * @note 現在の表示内容と異なる列範囲だけが送られる（グレースケールのビットプレーン切り替え等に使用）。
+ *       描画バッファは変更されないため、次のSSD1306_Update()で描画バッファの内容に戻る
+ */
+void SSD1306_UpdateFrom(const uint8_t *frame);
+
+/**
+ * @brief ページ形式のビットマップを描画バッファを経由せずにディスプレイへ直接転送する（フラッシュからそのまま送信）
+ * @param x 左端のX座標
+ * @param page 上端のページ（Y座標 / 8）
+ * @param bitmap ページ形式のビットマップ（width × pagesバイト）
+ * @param width 幅（ピクセル）
+ * @param pages 高さ（ページ数）
+ * @param flags SSD1306_STREAM_SHADOW / SSD1306_STREAM_BUFFER の組み合わせ（0=転送のみ）
+ * @note コピー・差分比較なしでページごとに1回のデータ書き込みを行う。画面外にはみ出す部分は送らない。
+ *       SSD1306_STREAM_SHADOWを指定しない場合、表示内容の控えが分からなくなるため次の更新は全画面転送になる。
+ *       以降も表示し続ける背景等はSSD1306_STREAM_SHADOW | SSD1306_STREAM_BUFFERを指定し、その上に描画して差分更新する
+ */
+void SSD1306_StreamBitmap(uint8_t x, uint8_t page, const uint8_t *bitmap, uint8_t width, uint8_t pages, uint8_t flags);
+
+/**
+ * @brief 画像アセットを描画バッファを経由せずにディスプレイへ直接転送する
+ * @param x 左端のX座標
+ * @param page 上端のページ（Y座標 / 8）
+ * @param image 画像（tools/imgc.pyで生成）
+ * @param flags SSD1306_STREAM_SHADOW / SSD1306_STREAM_BUFFER の組み合わせ（0=転送のみ）
+ * @note 非圧縮画像はSSD1306_StreamBitmap()と同じくコピーなしで送る。RLE画像はページ行ごとに展開して送る（スタックに128バイト）。
+ *       高さが8の倍数でない画像は、最後のページの残りの行も消去される
+ */
+void SSD1306_StreamImage(uint8_t x, uint8_t page, const SSD1306_Image *image, uint8_t flags);
+
+/**
+ * @brief 変更した領域を登録する（SSD1306_UpdateDirty()の転送範囲）
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @note 描画関数と同じく原点が加算される。ページ単位の列範囲として記録される（複数回の登録は範囲が合成される）
+ */
+void SSD1306_Invalidate(int16_t x, int16_t y, uint8_t width, uint8_t height);
+
+/**
+ * @brief 登録した領域だけを比較してディスプレイに転送する
+ * @note バッファ全体の比較を行わないため、変更箇所が分かっている場合はSSD1306_Update()より高速。
+ *       登録していない領域の変更は転送されない
+ */
+void SSD1306_UpdateDirty(void);
+
+/**
+ * @brief 優先して転送する領域を登録する（SSD1306_UpdateStep()で最初に転送される）
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @note 警報表示など、画面全体が変わるときにも先に表示したい領域に使う。転送が済むと登録は消える
+ */
+void SSD1306_InvalidatePriority(int16_t x, int16_t y, uint8_t width, uint8_t height);
+
+/**
+ * @brief 変更箇所を予算の範囲で転送する（続きは次の呼び出しで転送される）
+ * @param budget このステップで使うバスのバイト数（データに加え、列範囲ごとにSSD1306_STEP_SPAN_OVERHEADバイト）
+ * @return 1=表示が描画バッファに追いついた, 0=未転送の変更が残っている
+ * @note 優先領域、続いて前回の続きのページから順に転送する。予算を超える列範囲は途中で区切られる。
+ *       表示内容の控えは実際に送ったバイトだけ更新されるため、途中で止めても差分がずれることはない。
+ *       時間で指定する場合はSSD1306_STEP_BUDGET_US()でバイト数に換算する
+ */
+uint8_t SSD1306_UpdateStep(uint16_t budget);
+
 /**
  * @brief ディスプレイをオンにする
+ * @note 表示設定の関数（SSD1306_DisplayOff()〜SSD1306_SetContrast()も同様）はコマンドをキューに積むだけで、
+ *       次の転送のアドレス設定と同じトランザクションで送られる（SSD1306_Update*()・SSD1306_Poll()）。
+ *       すぐに反映するにはSSD1306_FlushCommands()を呼び出す
  */
 void SSD1306_DisplayOn(void);
 
@@ -124,16 +356,68 @@ void SSD1306_DisplayInverse(void);
 /**
  * @brief ディスプレイのコントラストを設定する
  * @param contrast コントラスト値 (0-255)
+ * @note 1フレームの間に何度呼び出しても、送られるのは最後の値だけ（表示中の値に戻した場合は何も送られない）
  */
 void SSD1306_SetContrast(uint8_t contrast);
 
+/**
+ * @brief キューに積まれた表示設定のコマンドをすぐに送る
+ * @note 表示に回したフレームの転送中であれば、その完了を待ってから送る
+ */
+void SSD1306_FlushCommands(void);
+
+/**
+ * @brief クリップ矩形を設定する（全ての描画関数に適用される）
+ * @param x 左上角のX座標（画面座標、原点の影響を受けない）
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @note 画面との共通部分が使われる。範囲外の図形は描画前に判定して省略される
+ */
+void SSD1306_SetClip(int16_t x, int16_t y, int16_t width, int16_t height);
+
+/**
+ * @brief クリップ矩形を画面全体に戻す
+ */
+void SSD1306_ResetClip(void);
+
+/**
+ * @brief 描画の原点を設定する（以降の描画関数の座標に加算される）
+ * @param x 原点のX座標（画面座標）
+ * @param y 原点のY座標（画面座標）
+ * @note 座標は符号付きのため、原点と組み合わせて画面外にはみ出す図形も描画できる
+ */
+void SSD1306_SetOrigin(int16_t x, int16_t y);
+
+/**
+ * @brief 現在の描画の原点を取得する
+ * @param x 原点のX座標の格納先（画面座標）
+ * @param y 原点のY座標の格納先（画面座標）
+ * @note 描画関数を組み合わせる拡張モジュールが、折り返し等を画面座標で判定するために使う
+ */
+void SSD1306_GetOrigin(int16_t *x, int16_t *y);
+
+/**
+ * @brief 塗りつぶし関数の模様を設定する
+ * @param pattern SSD1306_PATTERN_SOLID / _25 / _50 / _75 / _HATCH / _CROSSHATCH
+ * @note SSD1306_Fill*関数に適用され、模様の1のビットだけにcolorの操作（点灯・消去・反転）が行われる。枠線・文字・ビットマップには適用されない
+ */
+void SSD1306_SetFillPattern(uint8_t pattern);
+
+/**
+ * @brief 塗りつぶし関数の模様を任意のビット列で設定する
+ * @param pattern 8バイトの模様（X座標 & 7 番目のバイトが列、LSBが上。NULLで塗りつぶし）
+ * @note ポインタを保持するため、設定中は配列を有効なままにすること
+ */
+void SSD1306_SetFillPatternBits(const uint8_t *pattern);
+
 /**
  * @brief 指定座標にピクセルを描画する
- * @param x X座標 (0-127)
- * @param y Y座標 (0-63)
- * @param color 色 (0=消去, 1=点灯)
+ * @param x X座標（画面外・クリップ範囲外の点は描画されない）
+ * @param y Y座標
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawPixel(uint8_t x, uint8_t y, uint8_t color);
+void SSD1306_DrawPixel(int16_t x, int16_t y, uint8_t color);
 
 /**
  * @brief 2点間に直線を描画する
@@ -141,9 +425,9 @@ void SSD1306_DrawPixel(uint8_t x, uint8_t y, uint8_t color);
  * @param y0 開始点のY座標
  * @param x1 終了点のX座標
  * @param y1 終了点のY座標
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+void SSD1306_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
 
 /**
  * @brief 矩形の枠線を描画する
@@ -151,9 +435,9 @@ void SSD1306_DrawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t co
  * @param y 左上角のY座標
  * @param width 幅
  * @param height 高さ
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void SSD1306_DrawRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color);
 
 /**
  * @brief 塗りつぶされた矩形を描画する
@@ -161,45 +445,45 @@ void SSD1306_DrawRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8
  * @param y 左上角のY座標
  * @param width 幅
  * @param height 高さ
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_FillRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color);
+void SSD1306_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color);
 /**
  * @brief 円の枠線を描画する
  * @param x0 中心のX座標
  * @param y0 中心のY座標
  * @param radius 半径
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint8_t color);
+void SSD1306_DrawCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color);
 
 /**
  * @brief 塗りつぶされた円を描画する
  * @param x0 中心のX座標
  * @param y0 中心のY座標
  * @param radius 半径
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_FillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint8_t color);
+void SSD1306_FillCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color);
 /**
  * @brief 楕円の枠線を描画する
  * @param x0 バウンディングボックス左上のX座標
  * @param y0 バウンディングボックス左上のY座標
- * @param x1 バウンディングボックス右下のX座標
- * @param y1 バウンディングボックス右下のY座標
- * @param color 色 (0=消去, 1=点灯)
+ * @param x1 バウンディングボックスの幅
+ * @param y1 バウンディングボックスの高さ
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawEllipse(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+void SSD1306_DrawEllipse(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t color);
 
 /**
  * @brief 塗りつぶされた楕円を描画する
  * @param x0 バウンディングボックス左上のX座標
  * @param y0 バウンディングボックス左上のY座標
- * @param x1 バウンディングボックス右下のX座標
- * @param y1 バウンディングボックス右下のY座標
- * @param color 色 (0=消去, 1=点灯)
+ * @param x1 バウンディングボックスの幅
+ * @param y1 バウンディングボックスの高さ
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_FillEllipse(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color);
+void SSD1306_FillEllipse(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t color);
 /**
  * @brief 三角形の枠線を描画する
  * @param x0 第1頂点のX座標
@@ -208,9 +492,10 @@ void SSD1306_FillEllipse(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t
  * @param y1 第2頂点のY座標
  * @param x2 第3頂点のX座標
  * @param y2 第3頂点のY座標
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @note 各辺は終点のピクセルを除いて描くため、SSD1306_COLOR_INVERTでも頂点は1回だけ反転される。鋭い頂点の近くで2辺が同じピクセルを通る場合はそのピクセルが2回反転され元に戻る
  */
-void SSD1306_DrawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+void SSD1306_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color);
 
 /**
  * @brief 塗りつぶされた三角形を描画する
@@ -220,68 +505,307 @@ void SSD1306_DrawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_
  * @param y1 第2頂点のY座標
  * @param x2 第3頂点のX座標
  * @param y2 第3頂点のY座標
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_FillTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color);
+void SSD1306_FillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color);
 /**
  * @brief 角の丸い矩形の枠線を描画する
  * @param x0 左上角のX座標
  * @param y0 左上角のY座標
- * @param x1 右下角のX座標
- * @param y1 右下角のY座標
+ * @param x1 幅
+ * @param y1 高さ
  * @param radius 角の丸みの半径
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawRoundRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color);
+void SSD1306_DrawRoundRect(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color);
 
 /**
  * @brief 角の丸い塗りつぶされた矩形を描画する
  * @param x0 左上角のX座標
  * @param y0 左上角のY座標
- * @param x1 右下角のX座標
- * @param y1 右下角のY座標
+ * @param x1 幅
+ * @param y1 高さ
  * @param radius 角の丸みの半径
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_FillRoundRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color);
+void SSD1306_FillRoundRect(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color);
 
 /**
  * @brief ASCII文字を描画する
  * @param x 描画開始のX座標
  * @param y 描画開始のY座標
  * @param c 描画する文字
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawChar(uint8_t x, uint8_t y, char c, uint8_t color);
+void SSD1306_DrawChar(int16_t x, int16_t y, char c, uint8_t color);
 
 /**
  * @brief UTF-8文字を描画する（ギリシャ文字等対応）
  * @param x 描画開始のX座標
  * @param y 描画開始のY座標
  * @param utf8_bytes UTF-8バイト列のポインタ
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawCharUTF8(uint8_t x, uint8_t y, const uint8_t *utf8_bytes, uint8_t color);
+void SSD1306_DrawCharUTF8(int16_t x, int16_t y, const uint8_t *utf8_bytes, uint8_t color);
+
+/**
+ * @brief UTF-8バイト列から1文字をデコードする
+ * @param str UTF-8バイト列へのポインタのアドレス（デコードした分だけ進む）
+ * @return Unicodeコードポイント（終端では0を返しポインタは進まない）
+ * @note 不正・途中で切れたシーケンスはSSD1306_UTF8_REPLACEMENTを返し、終端を読み飛ばさない
+ */
+uint32_t SSD1306_DecodeUTF8(const uint8_t **str);
 
 /**
  * @brief 文字列を描画する（UTF-8対応）
  * @param x 描画開始のX座標
  * @param y 描画開始のY座標
  * @param str 描画する文字列のポインタ
- * @param color 色 (0=消去, 1=点灯)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_DrawString(int16_t x, int16_t y, const char *str, uint8_t color);
+
+/**
+ * @brief 整数を描画する（sprintf不要）
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param value 値
+ * @param min_digits 最小桁数（不足分は0で埋める、0=埋めない）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 描画後のX座標（続けて単位等を描画できる）
+ * @note 折り返しは行わず、画面外はクリップされる
+ */
+int16_t SSD1306_DrawInt(int16_t x, int16_t y, int32_t value, uint8_t min_digits, uint8_t color);
+
+/**
+ * @brief 固定小数点数を描画する（sprintf・浮動小数点不要）
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param value 10^decimals倍した値（例: 23.5 → 235, decimals=1）
+ * @param decimals 小数点以下の桁数 (0-9)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 描画後のX座標
+ */
+int16_t SSD1306_DrawFixed(int16_t x, int16_t y, int32_t value, uint8_t decimals, uint8_t color);
+
+/**
+ * @brief 時刻を"HH:MM:SS"形式（0埋め）で描画する
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param hours 時
+ * @param minutes 分
+ * @param seconds 秒
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 描画後のX座標
+ */
+int16_t SSD1306_DrawTime(int16_t x, int16_t y, uint8_t hours, uint8_t minutes, uint8_t seconds, uint8_t color);
+
+/**
+ * @brief 文字列を整数倍に拡大して描画する（UTF-8対応）
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param str 描画する文字列のポインタ
+ * @param scale 拡大率 (1-4)
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @note 1文字は(8*scale)x(8*scale)ピクセル。折り返し・クリッピングはSSD1306_DrawString()と同じ
+ */
+void SSD1306_DrawStringScaled(int16_t x, int16_t y, const char *str, uint8_t scale, uint8_t color);
+
+/**
+ * @brief ビットマップ画像を描画する（ページ形式、背景は透過）
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param bitmap ビットマップデータのポインタ（SSD1306_BITMAP_PAGE_MAJOR形式）
+ * @param width ビットマップの幅
+ * @param height ビットマップの高さ
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
  */
-void SSD1306_DrawString(uint8_t x, uint8_t y, const char *str, uint8_t color);
+void SSD1306_DrawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t color);
 
 /**
- * @brief ビットマップ画像を描画する
+ * @brief 形式と描画モードを指定してビットマップ画像を描画する
  * @param x 描画開始のX座標
  * @param y 描画開始のY座標
  * @param bitmap ビットマップデータのポインタ
  * @param width ビットマップの幅
  * @param height ビットマップの高さ
- * @param color 色 (0=消去, 1=点灯)
+ * @param format データ形式 (SSD1306_BITMAP_PAGE_MAJOR / SSD1306_BITMAP_ROW_MAJOR)
+ * @param mode 描画モード (SSD1306_BLIT_CLEAR / SET / OPAQUE / INVERTED / XOR)
+ * @note 画面外・クリップ範囲外は切り取られる。ページ形式をY座標8の倍数に不透過で描画する場合はページごとにmemcpyで転送する
+ * @note 行形式は8x8ブロック単位のビット転置でページ形式に変換してから転送する
+ */
+void SSD1306_DrawBitmapEx(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t format, uint8_t mode);
+
+/**
+ * @brief 画像アセットを描画する
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param image 画像（tools/imgc.pyで生成）
+ * @param mode SSD1306_BLIT_SET / CLEAR / OPAQUE / INVERTED / XOR
+ * @note RLE画像はページ行ごとに展開しながら転送するため、展開後の画像全体を置くRAMは不要（スタックに最大128バイト）
+ */
+void SSD1306_DrawImage(int16_t x, int16_t y, const SSD1306_Image *image, uint8_t mode);
+
+/**
+ * @brief 描画バッファの矩形領域をページ形式のビットマップとして読み出す
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param bitmap 読み出し先（幅 x ((高さ+7)/8) バイト）
+ * @param width 幅
+ * @param height 高さ
+ * @note 画面外のピクセルは0として読み出される。SSD1306_BLIT_OPAQUEで同じ位置に描画すると元に戻る
+ */
+void SSD1306_ReadBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint8_t width, uint8_t height);
+
+
+/**
+ * @brief フォントからグリフを検索する（二分探索）
+ * @param font フォント
+ * @param codepoint Unicodeコードポイント
+ * @return グリフ情報のポインタ（見つからない場合はNULL）
  */
-void SSD1306_DrawBitmap(uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t color);
+const SSD1306_FontGlyph *SSD1306_FindFontGlyph(const SSD1306_Font *font, uint32_t codepoint);
 
+/**
+ * @brief 指定フォントで1文字を描画する
+ * @param x 描画開始のX座標
+ * @param y セル上端のY座標
+ * @param font フォント
+ * @param codepoint Unicodeコードポイント
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 送り幅（ピクセル）
+ */
+uint8_t SSD1306_DrawCharFont(int16_t x, int16_t y, const SSD1306_Font *font, uint32_t codepoint, uint8_t color);
+
+/**
+ * @brief 指定フォントで文字列を描画する（UTF-8対応、プロポーショナル）
+ * @param x 描画開始のX座標
+ * @param y セル上端のY座標
+ * @param font フォント
+ * @param str 描画する文字列のポインタ
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_DrawStringFont(int16_t x, int16_t y, const SSD1306_Font *font, const char *str, uint8_t color);
+
+/**
+ * @brief 文字列の描画幅を計測する（UTF-8対応）
+ * @param font フォント（NULLの場合は8x8内蔵フォント）
+ * @param str 文字列のポインタ
+ * @return 最も長い行の幅（ピクセル、'\n'で改行）
+ */
+uint16_t SSD1306_MeasureString(const SSD1306_Font *font, const char *str);
+
+/**
+ * @brief 矩形内に文字列をレイアウトして描画する（UTF-8対応）
+ * @param x 矩形左上のX座標
+ * @param y 矩形左上のY座標
+ * @param width 矩形の幅
+ * @param height 矩形の高さ
+ * @param font フォント（NULLの場合は8x8内蔵フォント）
+ * @param str 文字列のポインタ
+ * @param flags SSD1306_TEXT_ALIGN_* | SSD1306_TEXT_WRAP | SSD1306_TEXT_ELLIPSIS
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 描画した行数
+ * @note 描画は矩形内にクリップされる。ヒープは使用しない
+ */
+uint8_t SSD1306_DrawTextBox(int16_t x, int16_t y, uint8_t width, uint8_t height, const SSD1306_Font *font,
+                            const char *str, uint8_t flags, uint8_t color);
+
+/**
+ * @brief 固定小数点の正弦（テーブル参照＋線形補間、浮動小数点不要）
+ * @param angle 角度（0.1度単位、SSD1306_ANGLE_FULL=1周）
+ * @return sin(angle) x 32767 (Q15)
+ */
+int16_t SSD1306_Sin(int16_t angle);
+
+/**
+ * @brief 固定小数点の余弦
+ * @param angle 角度（0.1度単位、SSD1306_ANGLE_FULL=1周）
+ * @return cos(angle) x 32767 (Q15)
+ */
+int16_t SSD1306_Cos(int16_t angle);
+
+/**
+ * @brief 極座標から画面座標を求める
+ * @param cx 中心のX座標
+ * @param cy 中心のY座標
+ * @param radius 半径
+ * @param angle 角度（0=12時方向、時計回り、0.1度単位）
+ * @param x X座標の格納先
+ * @param y Y座標の格納先
+ */
+void SSD1306_PolarPoint(int16_t cx, int16_t cy, uint8_t radius, int16_t angle, int16_t *x, int16_t *y);
+
+/**
+ * @brief 中心から放射方向の線分を描画する
+ * @param cx 中心のX座標
+ * @param cy 中心のY座標
+ * @param r0 線分の内側の半径
+ * @param r1 線分の外側の半径
+ * @param angle 角度（0=12時方向、時計回り、0.1度単位）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_DrawLinePolar(int16_t cx, int16_t cy, uint8_t r0, uint8_t r1, int16_t angle, uint8_t color);
+
+/**
+ * @brief 等間隔の目盛りを円周上に描画する
+ * @param cx 中心のX座標
+ * @param cy 中心のY座標
+ * @param r0 目盛りの内側の半径
+ * @param r1 目盛りの外側の半径（r0と同じ場合は点）
+ * @param count 1周あたりの目盛り数（12時方向から開始）
+ * @param skip_every この間隔ごとの目盛りを省略する（別の目盛りと重ねる場合、0=省略なし）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_DrawTickRing(int16_t cx, int16_t cy, uint8_t r0, uint8_t r1, uint8_t count, uint8_t skip_every, uint8_t color);
+
+/**
+ * @brief 時計の針・メーターの指針を描画する
+ * @param cx 中心のX座標
+ * @param cy 中心のY座標
+ * @param length 針の長さ
+ * @param width 根元の幅（1以下は線）
+ * @param angle 角度（0=12時方向、時計回り、0.1度単位）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @note 三角形の塗りつぶしは中心線のピクセルを避けて描くため、SSD1306_COLOR_INVERTでも重なりは元に戻らない
+ */
+void SSD1306_DrawNeedle(int16_t cx, int16_t cy, uint8_t length, uint8_t width, int16_t angle, uint8_t color);
+
+/**
+ * @brief 円弧を描画する
+ * @param x0 中心のX座標
+ * @param y0 中心のY座標
+ * @param radius 半径
+ * @param start_angle 開始角度（0=12時方向、時計回り、0.1度単位）
+ * @param end_angle 終了角度（開始から時計回りに測る、差が1周以上の場合は全周、0の場合は描画しない）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @note 中点円アルゴリズムの8分円ごとに範囲判定を行い、完全に含まれる8分円は判定を省略する。8分円の境界の点は1回だけ描くため、SSD1306_COLOR_INVERTでも各ピクセルは1回だけ反転される
+ */
+void SSD1306_DrawArc(int16_t x0, int16_t y0, uint8_t radius, int16_t start_angle, int16_t end_angle, uint8_t color);
+
+/**
+ * @brief 扇形を塗りつぶす
+ * @param x0 中心のX座標
+ * @param y0 中心のY座標
+ * @param radius 半径
+ * @param start_angle 開始角度（0=12時方向、時計回り、0.1度単位）
+ * @param end_angle 終了角度（開始から時計回りに測る）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_FillSector(int16_t x0, int16_t y0, uint8_t radius, int16_t start_angle, int16_t end_angle, uint8_t color);
+
+/**
+ * @brief 円環の一部（プログレスリング等）を塗りつぶす
+ * @param x0 中心のX座標
+ * @param y0 中心のY座標
+ * @param inner_radius 内側の半径（0の場合は扇形と同じ）
+ * @param outer_radius 外側の半径
+ * @param start_angle 開始角度（0=12時方向、時計回り、0.1度単位）
+ * @param end_angle 終了角度（開始から時計回りに測る）
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @note 列ごとに整数演算で縦スパンを求めてページ単位で書き込む（三角関数・平方根は使わない）
+ */
+void SSD1306_FillAnnulusSector(int16_t x0, int16_t y0, uint8_t inner_radius, uint8_t outer_radius,
+                               int16_t start_angle, int16_t end_angle, uint8_t color);
 
 #endif
@@ -6,6 +6,9 @@
 #define SSD1306_SCL GPIO_Pin_16
 #define SSD1306_SDA GPIO_Pin_17
 
+// External SPI flash holding glyph images (SPI1: PA5-SCK, PA6-MISO, PA7-MOSI)
+#define SSD1306_FLASH_CS GPIO_Pin_4
+
 /**
  * @brief ミリ秒単位の遅延処理（HAL層）
  * @param ms 遅延時間（ミリ秒）
@@ -27,4 +30,49 @@ void SSD1306_IIC_Init_HAL(void);
  * @note マイコン固有のI2C送信処理を実行
  */
 void SSD1306_IIC_HAL(uint8_t Mode, uint8_t *Command, uint8_t Length);
+
+/**
+ * @brief 制御バイトを含むパケットを1回のI2C転送で送信（HAL層）
+ * @param Packet 送信するデータのポインタ（先頭が制御バイト SSD1306_MODE_COMMAND / SSD1306_MODE_DATA）
+ * @param Length 制御バイトを含むバイト数
+ * @note 先頭に何も付け加えずそのまま送るため、DMAやwrite()による転送にメモリ上のデータを直接渡せる。
+ *       Packetの内容は戻った後に書き換えられるので、戻る前に送信を完了すること
+ */
+void SSD1306_IIC_Packet_HAL(uint8_t *Packet, uint16_t Length);
+
+/**
+ * @brief パケットの送信を開始する（HAL層、SSD1306_Present()の転送に使用）
+ * @param Packet 送信するデータのポインタ（先頭が制御バイト）
+ * @param Length 制御バイトを含むバイト数
+ * @note DMA等で送信する場合は開始だけして戻り、完了までPacketの内容を保持したまま読み出すこと。
+ *       完了割り込みからSSD1306_Poll()を呼び出すと次のパケットが開始される
+ */
+void SSD1306_IIC_Packet_Start_HAL(uint8_t *Packet, uint16_t Length);
+
+/**
+ * @brief SSD1306_IIC_Packet_Start_HAL()で開始した送信が実行中か（HAL層）
+ * @return 1=送信中, 0=完了
+ */
+uint8_t SSD1306_IIC_Busy_HAL(void);
+
+/**
+ * @brief 溜めておいたI2C転送をまとめて送信する（HAL層）
+ * @note 1回の更新（SSD1306_Update()等）の終わりと、SSD1306_Poll()が転送を終えたときに呼ばれる。
+ *       呼び出しごとにすぐ送信するHALでは何もしない。Linuxのi2c-dev版は1回の更新を1回のioctlで送る
+ */
+void SSD1306_IIC_Flush_HAL(void);
+
+/**
+ * @brief 外部フラッシュの初期化（HAL層）
+ * @note グリフキャッシュ使用時のみ必要。Linuxではファイルで代替する
+ */
+void SSD1306_Flash_Init_HAL(void);
+
+/**
+ * @brief 外部フラッシュからデータを読み出す（HAL層）
+ * @param address 読み出し開始アドレス
+ * @param data 読み出し先バッファ
+ * @param length 読み出すバイト数
+ */
+void SSD1306_Flash_Read_HAL(uint32_t address, uint8_t *data, uint16_t length);
 #endif
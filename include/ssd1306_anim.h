@@ -0,0 +1,61 @@
+#ifndef __SSD1306_ANIM_H
+#define __SSD1306_ANIM_H
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// Frame stream format (written by tools/animc.py):
+//   frame  = page_mask, flags, then one span per set bit of page_mask (lowest page first)
+//   span   = start_col, end_col (inclusive), PackBits coded bytes for columns start_col..end_col
+//   flags  = SSD1306_ANIM_FRAME_KEY: span bytes are pixels; otherwise they are XORed onto the previous frame
+// An empty frame (no motion) is the two header bytes. Pages and columns are relative to the animation.
+
+#define SSD1306_ANIM_FRAME_KEY 0x01 // Span bytes replace the pixels instead of toggling them
+
+/**
+ * @brief アニメーション（差分フレームストリーム）
+ * @note tools/animc.py で連番画像から生成する
+ */
+typedef struct
+{
+    const uint8_t *data;     // フレームストリーム
+    uint32_t size;           // dataのバイト数
+    uint32_t loop_offset;    // 最後のフレームの次に再生するフレームの位置（0=ループしない）
+    uint16_t frame_count;    // dataに含まれるフレーム数
+    uint16_t frame_interval; // フレーム間隔（ミリ秒）
+    uint8_t width;           // 幅（ピクセル、128以下）
+    uint8_t height;          // 高さ（ピクセル、64以下）
+} SSD1306_Animation;
+
+/**
+ * @brief アニメーションの再生状態
+ * @note フィールドはSSD1306_Anim_*関数で操作する
+ */
+typedef struct
+{
+    const SSD1306_Animation *anim; // 再生中のアニメーション
+    uint32_t offset;               // 次のフレームの位置
+    uint16_t frame;                // 次のフレーム番号
+} SSD1306_AnimPlayer;
+
+/**
+ * @brief アニメーションの再生を先頭から開始する
+ * @param player 再生状態
+ * @param anim アニメーション
+ */
+void SSD1306_Anim_Start(SSD1306_AnimPlayer *player, const SSD1306_Animation *anim);
+
+/**
+ * @brief 次のフレームを描画バッファに展開する
+ * @param player 再生状態
+ * @param x 左上角のX座標（原点・クリップ矩形が適用される）
+ * @param y 左上角のY座標
+ * @return 1=フレームを展開した, 0=最後まで再生した（ループしないアニメーション）
+ * @note 変化したページの列範囲だけを直前のフレームにXORし、SSD1306_Invalidate()で登録する。
+ *       続けてSSD1306_UpdateDirty()を呼び出すと、展開も転送も動いた部分の大きさに比例する。
+ *       表示位置を変えず、アニメーションの領域に他の描画を重ねないこと（差分の前提が崩れる）
+ */
+uint8_t SSD1306_Anim_NextFrame(SSD1306_AnimPlayer *player, int16_t x, int16_t y);
+
+#endif
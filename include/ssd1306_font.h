@@ -1,68 +1,6 @@
 #ifndef _SSD1306_FONT_H
 #define _SSD1306_FONT_H
 
-// Complete UTF-8 character lookup table
-static const struct
-{
-    uint8_t utf8_bytes[3];
-    uint8_t font_index;
-} utf8_lookup[] = {
-    // Greek Uppercase Letters (Α-Ω)
-    {{0xCE, 0x91, 0x00}, 0},  // Α
-    {{0xCE, 0x92, 0x00}, 1},  // Β
-    {{0xCE, 0x93, 0x00}, 2},  // Γ
-    {{0xCE, 0x94, 0x00}, 3},  // Δ
-    {{0xCE, 0x95, 0x00}, 4},  // Ε
-    {{0xCE, 0x96, 0x00}, 5},  // Ζ
-    {{0xCE, 0x97, 0x00}, 6},  // Η
-    {{0xCE, 0x98, 0x00}, 7},  // Θ
-    {{0xCE, 0x99, 0x00}, 8},  // Ι
-    {{0xCE, 0x9A, 0x00}, 9},  // Κ
-    {{0xCE, 0x9B, 0x00}, 10}, // Λ
-    {{0xCE, 0x9C, 0x00}, 11}, // Μ
-    {{0xCE, 0x9D, 0x00}, 12}, // Ν
-    {{0xCE, 0x9E, 0x00}, 13}, // Ξ
-    {{0xCE, 0x9F, 0x00}, 14}, // Ο
-    {{0xCE, 0xA0, 0x00}, 15}, // Π
-    {{0xCE, 0xA1, 0x00}, 16}, // Ρ
-    {{0xCE, 0xA3, 0x00}, 17}, // Σ
-    {{0xCE, 0xA4, 0x00}, 18}, // Τ
-    {{0xCE, 0xA5, 0x00}, 19}, // Υ
-    {{0xCE, 0xA6, 0x00}, 20}, // Φ
-    {{0xCE, 0xA7, 0x00}, 21}, // Χ
-    {{0xCE, 0xA8, 0x00}, 22}, // Ψ
-    {{0xCE, 0xA9, 0x00}, 23}, // Ω
-
-    // Greek Lowercase Letters (α-ω)
-    {{0xCE, 0xB1, 0x00}, 24}, // α
-    {{0xCE, 0xB2, 0x00}, 25}, // β
-    {{0xCE, 0xB3, 0x00}, 26}, // γ
-    {{0xCE, 0xB4, 0x00}, 27}, // δ
-    {{0xCE, 0xB5, 0x00}, 28}, // ε
-    {{0xCE, 0xB6, 0x00}, 29}, // ζ
-    {{0xCE, 0xB7, 0x00}, 30}, // η
-    {{0xCE, 0xB8, 0x00}, 31}, // θ
-    {{0xCE, 0xB9, 0x00}, 32}, // ι
-    {{0xCE, 0xBA, 0x00}, 33}, // κ
-    {{0xCE, 0xBB, 0x00}, 34}, // λ
-    {{0xCE, 0xBC, 0x00}, 35}, // μ
-    {{0xCE, 0xBD, 0x00}, 36}, // ν
-    {{0xCE, 0xBE, 0x00}, 37}, // ξ
-    {{0xCE, 0xBF, 0x00}, 38}, // ο
-    {{0xCF, 0x80, 0x00}, 39}, // π
-    {{0xCF, 0x81, 0x00}, 40}, // ρ
-    {{0xCF, 0x83, 0x00}, 41}, // σ
-    {{0xCF, 0x84, 0x00}, 42}, // τ
-    {{0xCF, 0x85, 0x00}, 43}, // υ
-    {{0xCF, 0x86, 0x00}, 44}, // φ
-    {{0xCF, 0x87, 0x00}, 45}, // χ
-    {{0xCF, 0x88, 0x00}, 46}, // ψ
-    {{0xCF, 0x89, 0x00}, 47}, // ω
-
-    // Special Symbols
-    {{0xE2, 0x84, 0x83}, 48}, // ℃
-};
-
 static const uint8_t ascii_font[][8] = {
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // 0x20 ' '
     {0x00, 0x00, 0x06, 0x5F, 0x5F, 0x06, 0x00, 0x00}, // 0x21 '!'
@@ -160,63 +98,67 @@ static const uint8_t ascii_font[][8] = {
     {0x00, 0x41, 0x41, 0x77, 0x3E, 0x08, 0x08, 0x00}, // 0x7D '}'
     {0x02, 0x03, 0x01, 0x03, 0x02, 0x03, 0x01, 0x00}  // 0x7E '~'
 };
-
-// Complete Greek alphabet font data (uppercase and lowercase)
-static const uint8_t extended_font[][8] = {
+// Extended glyphs (Greek alphabet and special symbols) keyed by Unicode code point
+// Entries must stay sorted by code point: the table itself is the binary search index
+static const struct
+{
+    uint16_t codepoint;
+    uint8_t bitmap[8];
+} extended_font[] = {
     // Greek Uppercase Letters
-    {0x7C, 0x7E, 0x0B, 0x09, 0x0B, 0x7E, 0x7C, 0x00}, // Α (Alpha) - 0
-    {0x41, 0x7F, 0x7F, 0x49, 0x49, 0x7F, 0x36, 0x00}, // Β (Beta) - 1
-    {0x7F, 0x7F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00}, // Γ (Gamma) - 2
-    {0x3E, 0x7F, 0x41, 0x41, 0x41, 0x7F, 0x3E, 0x00}, // Δ (Delta) - 3
-    {0x41, 0x7F, 0x7F, 0x49, 0x5D, 0x41, 0x63, 0x00}, // Ε (Epsilon) - 4
-    {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00}, // Ζ (Zeta) - 5
-    {0x7F, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x7F, 0x00}, // Η (Eta) - 6
-    {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x3E, 0x00}, // Θ (Theta) - 7
-    {0x00, 0x00, 0x41, 0x7F, 0x7F, 0x41, 0x00, 0x00}, // Ι (Iota) - 8
-    {0x41, 0x7F, 0x7F, 0x08, 0x1C, 0x77, 0x63, 0x00}, // Κ (Kappa) - 9
-    {0x7E, 0x7F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00}, // Λ (Lambda) - 10
-    {0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F, 0x00}, // Μ (Mu) - 11
-    {0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F, 0x00}, // Ν (Nu) - 12
-    {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x3E, 0x00}, // Ξ (Xi) - 13
-    {0x1C, 0x3E, 0x63, 0x41, 0x41, 0x63, 0x22, 0x00}, // Ο (Omicron) - 14
-    {0x7F, 0x7F, 0x01, 0x01, 0x01, 0x7F, 0x7F, 0x00}, // Π (Pi) - 15
-    {0x41, 0x7F, 0x7F, 0x09, 0x09, 0x0F, 0x06, 0x00}, // Ρ (Rho) - 16
-    {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, 0x00}, // Σ (Sigma) - 17
-    {0x03, 0x03, 0x7F, 0x7F, 0x03, 0x03, 0x03, 0x00}, // Τ (Tau) - 18
-    {0x3F, 0x7F, 0x40, 0x40, 0x40, 0x7F, 0x3F, 0x00}, // Υ (Upsilon) - 19
-    {0x30, 0x78, 0x4F, 0x47, 0x4F, 0x78, 0x30, 0x00}, // Φ (Phi) - 20
-    {0x63, 0x77, 0x1C, 0x08, 0x1C, 0x77, 0x63, 0x00}, // Χ (Chi) - 21
-    {0x30, 0x78, 0x4F, 0x41, 0x41, 0x7F, 0x3E, 0x00}, // Ψ (Psi) - 22
-    {0x3E, 0x41, 0x41, 0x41, 0x22, 0x14, 0x6B, 0x00}, // Ω (Omega) - 23
+    {0x0391, {0x7C, 0x7E, 0x0B, 0x09, 0x0B, 0x7E, 0x7C, 0x00}}, // Α (Alpha)
+    {0x0392, {0x41, 0x7F, 0x7F, 0x49, 0x49, 0x7F, 0x36, 0x00}}, // Β (Beta)
+    {0x0393, {0x7F, 0x7F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00}}, // Γ (Gamma)
+    {0x0394, {0x3E, 0x7F, 0x41, 0x41, 0x41, 0x7F, 0x3E, 0x00}}, // Δ (Delta)
+    {0x0395, {0x41, 0x7F, 0x7F, 0x49, 0x5D, 0x41, 0x63, 0x00}}, // Ε (Epsilon)
+    {0x0396, {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x49, 0x49, 0x00}}, // Ζ (Zeta)
+    {0x0397, {0x7F, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x7F, 0x00}}, // Η (Eta)
+    {0x0398, {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x3E, 0x00}}, // Θ (Theta)
+    {0x0399, {0x00, 0x00, 0x41, 0x7F, 0x7F, 0x41, 0x00, 0x00}}, // Ι (Iota)
+    {0x039A, {0x41, 0x7F, 0x7F, 0x08, 0x1C, 0x77, 0x63, 0x00}}, // Κ (Kappa)
+    {0x039B, {0x7E, 0x7F, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00}}, // Λ (Lambda)
+    {0x039C, {0x7F, 0x7F, 0x0E, 0x1C, 0x0E, 0x7F, 0x7F, 0x00}}, // Μ (Mu)
+    {0x039D, {0x7F, 0x7F, 0x06, 0x0C, 0x18, 0x7F, 0x7F, 0x00}}, // Ν (Nu)
+    {0x039E, {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x3E, 0x00}}, // Ξ (Xi)
+    {0x039F, {0x1C, 0x3E, 0x63, 0x41, 0x41, 0x63, 0x22, 0x00}}, // Ο (Omicron)
+    {0x03A0, {0x7F, 0x7F, 0x01, 0x01, 0x01, 0x7F, 0x7F, 0x00}}, // Π (Pi)
+    {0x03A1, {0x41, 0x7F, 0x7F, 0x09, 0x09, 0x0F, 0x06, 0x00}}, // Ρ (Rho)
+    {0x03A3, {0x3E, 0x7F, 0x49, 0x49, 0x49, 0x7F, 0x36, 0x00}}, // Σ (Sigma)
+    {0x03A4, {0x03, 0x03, 0x7F, 0x7F, 0x03, 0x03, 0x03, 0x00}}, // Τ (Tau)
+    {0x03A5, {0x3F, 0x7F, 0x40, 0x40, 0x40, 0x7F, 0x3F, 0x00}}, // Υ (Upsilon)
+    {0x03A6, {0x30, 0x78, 0x4F, 0x47, 0x4F, 0x78, 0x30, 0x00}}, // Φ (Phi)
+    {0x03A7, {0x63, 0x77, 0x1C, 0x08, 0x1C, 0x77, 0x63, 0x00}}, // Χ (Chi)
+    {0x03A8, {0x30, 0x78, 0x4F, 0x41, 0x41, 0x7F, 0x3E, 0x00}}, // Ψ (Psi)
+    {0x03A9, {0x3E, 0x41, 0x41, 0x41, 0x22, 0x14, 0x6B, 0x00}}, // Ω (Omega)
 
     // Greek Lowercase Letters
-    {0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, 0x00}, // α (alpha) - 24
-    {0x7F, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00}, // β (beta) - 25
-    {0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00}, // γ (gamma) - 26
-    {0x38, 0x44, 0x44, 0x44, 0x38, 0x04, 0x00, 0x00}, // δ (delta) - 27
-    {0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00}, // ε (epsilon) - 28
-    {0x08, 0x7E, 0x09, 0x01, 0x02, 0x00, 0x00, 0x00}, // ζ (zeta) - 29
-    {0x18, 0x24, 0x24, 0x24, 0x7C, 0x00, 0x00, 0x00}, // η (eta) - 30
-    {0x38, 0x44, 0x44, 0x38, 0x44, 0x44, 0x38, 0x00}, // θ (theta) - 31
-    {0x00, 0x44, 0x7C, 0x40, 0x00, 0x00, 0x00, 0x00}, // ι (iota) - 32
-    {0x40, 0x7C, 0x08, 0x10, 0x68, 0x04, 0x00, 0x00}, // κ (kappa) - 33
-    {0x02, 0x01, 0x7E, 0x80, 0x00, 0x00, 0x00, 0x00}, // λ (lambda) - 34
-    {0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x7C, 0x80}, // μ (mu) - 35
-    {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x00}, // ν (nu) - 36
-    {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00, 0x00}, // ξ (xi) - 37
-    {0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00}, // ο (omicron) - 38
-    {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x00}, // π (pi) - 39
-    {0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, 0x00}, // ρ (rho) - 40
-    {0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, 0x00}, // σ (sigma) - 41
-    {0x04, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00}, // τ (tau) - 42
-    {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00, 0x00}, // υ (upsilon) - 43
-    {0x30, 0x48, 0xFC, 0x48, 0x30, 0x00, 0x00, 0x00}, // φ (phi) - 44
-    {0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00}, // χ (chi) - 45
-    {0x30, 0x48, 0xFC, 0x48, 0x30, 0x00, 0x00, 0x00}, // ψ (psi) - 46
-    {0x44, 0x3C, 0x04, 0x7C, 0x44, 0x00, 0x00, 0x00}, // ω (omega) - 47
+    {0x03B1, {0x20, 0x54, 0x54, 0x54, 0x78, 0x00, 0x00, 0x00}}, // α (alpha)
+    {0x03B2, {0x7F, 0x48, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00}}, // β (beta)
+    {0x03B3, {0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00}}, // γ (gamma)
+    {0x03B4, {0x38, 0x44, 0x44, 0x44, 0x38, 0x04, 0x00, 0x00}}, // δ (delta)
+    {0x03B5, {0x38, 0x54, 0x54, 0x54, 0x18, 0x00, 0x00, 0x00}}, // ε (epsilon)
+    {0x03B6, {0x08, 0x7E, 0x09, 0x01, 0x02, 0x00, 0x00, 0x00}}, // ζ (zeta)
+    {0x03B7, {0x18, 0x24, 0x24, 0x24, 0x7C, 0x00, 0x00, 0x00}}, // η (eta)
+    {0x03B8, {0x38, 0x44, 0x44, 0x38, 0x44, 0x44, 0x38, 0x00}}, // θ (theta)
+    {0x03B9, {0x00, 0x44, 0x7C, 0x40, 0x00, 0x00, 0x00, 0x00}}, // ι (iota)
+    {0x03BA, {0x40, 0x7C, 0x08, 0x10, 0x68, 0x04, 0x00, 0x00}}, // κ (kappa)
+    {0x03BB, {0x02, 0x01, 0x7E, 0x80, 0x00, 0x00, 0x00, 0x00}}, // λ (lambda)
+    {0x03BC, {0x00, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x7C, 0x80}}, // μ (mu)
+    {0x03BD, {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x00}}, // ν (nu)
+    {0x03BE, {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00, 0x00}}, // ξ (xi)
+    {0x03BF, {0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00}}, // ο (omicron)
+    {0x03C0, {0x7C, 0x04, 0x18, 0x04, 0x78, 0x00, 0x00, 0x00}}, // π (pi)
+    {0x03C1, {0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, 0x00}}, // ρ (rho)
+    {0x03C3, {0x38, 0x44, 0x44, 0x44, 0x20, 0x00, 0x00, 0x00}}, // σ (sigma)
+    {0x03C4, {0x04, 0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00}}, // τ (tau)
+    {0x03C5, {0x3C, 0x40, 0x40, 0x20, 0x7C, 0x00, 0x00, 0x00}}, // υ (upsilon)
+    {0x03C6, {0x30, 0x48, 0xFC, 0x48, 0x30, 0x00, 0x00, 0x00}}, // φ (phi)
+    {0x03C7, {0x44, 0x28, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00}}, // χ (chi)
+    {0x03C8, {0x30, 0x48, 0xFC, 0x48, 0x30, 0x00, 0x00, 0x00}}, // ψ (psi)
+    {0x03C9, {0x44, 0x3C, 0x04, 0x7C, 0x44, 0x00, 0x00, 0x00}}, // ω (omega)
 
     // Special Symbols
-    {0x07, 0x05, 0x07, 0x00, 0x3E, 0x41, 0x41, 0x00}, // ℃ (Celsius) - 48
+    {0x2103, {0x07, 0x05, 0x07, 0x00, 0x3E, 0x41, 0x41, 0x00}}, // ℃ (Celsius)
 };
 
 #endif
\ No newline at end of file
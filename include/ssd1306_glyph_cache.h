@@ -0,0 +1,97 @@
+#ifndef __SSD1306_GLYPH_CACHE_H
+#define __SSD1306_GLYPH_CACHE_H
+
+#include <stdint.h>
+
+// Number of glyphs kept in RAM (LRU replacement)
+#ifndef SSD1306_GLYPH_CACHE_SLOTS
+#define SSD1306_GLYPH_CACHE_SLOTS 16
+#endif
+
+// Largest glyph bitmap the cache can hold in bytes (16x16 pixels = 32 bytes)
+#ifndef SSD1306_GLYPH_CACHE_MAX_BYTES
+#define SSD1306_GLYPH_CACHE_MAX_BYTES 32
+#endif
+
+// External glyph image layout (little-endian, written by tools/fontc.py -f bin)
+//   0: "SGF1" magic
+//   4: uint16 glyph count
+//   6: uint8 height, baseline, line_height, default_advance
+//  10: uint16 reserved
+//  12: index of glyph count entries sorted by code point:
+//      uint16 code point, uint8 width, uint8 advance, uint32 bitmap address (relative to image start)
+//  followed by page-major glyph bitmaps
+#define SSD1306_GLYPH_IMAGE_HEADER_SIZE 12
+#define SSD1306_GLYPH_IMAGE_ENTRY_SIZE 8
+
+/**
+ * @brief 外部ストレージ読み出し関数
+ * @param address 読み出し開始アドレス
+ * @param data 読み出し先バッファ
+ * @param length 読み出すバイト数
+ */
+typedef void (*SSD1306_GlyphRead)(uint32_t address, uint8_t *data, uint16_t length);
+
+/**
+ * @brief 時刻取得関数（フェッチ時間の計測用、単位は任意のティック）
+ */
+typedef uint32_t (*SSD1306_GlyphClock)(void);
+
+/**
+ * @brief グリフキャッシュの統計情報
+ */
+typedef struct
+{
+    uint32_t hits;              // キャッシュヒット回数
+    uint32_t misses;            // キャッシュミス回数（ストレージからのフェッチ回数）
+    uint32_t storage_reads;     // ストレージ読み出しトランザクション数（索引の二分探索を含む）
+    uint32_t fetch_ticks_total; // フェッチに要した合計ティック
+    uint32_t fetch_ticks_max;   // 1回のフェッチの最大ティック
+} SSD1306_GlyphCacheStats;
+
+/**
+ * @brief 外部ストレージのグリフイメージを開き、キャッシュを初期化する
+ * @param read ストレージ読み出し関数（例: SSD1306_Flash_Read_HAL）
+ * @param base_address グリフイメージの先頭アドレス
+ * @param clock 時刻取得関数（NULLの場合フェッチ時間は計測しない）
+ * @return 1=成功, 0=グリフイメージが不正
+ */
+uint8_t SSD1306_GlyphCache_Init(SSD1306_GlyphRead read, uint32_t base_address, SSD1306_GlyphClock clock);
+
+/**
+ * @brief キャッシュ経由で1文字を描画する
+ * @param x 描画開始のX座標
+ * @param y セル上端のY座標
+ * @param codepoint Unicodeコードポイント
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 送り幅（ピクセル）
+ */
+uint8_t SSD1306_DrawCharCached(int16_t x, int16_t y, uint32_t codepoint, uint8_t color);
+
+/**
+ * @brief キャッシュ経由で文字列を描画する（UTF-8対応）
+ * @param x 描画開始のX座標
+ * @param y セル上端のY座標
+ * @param str 描画する文字列のポインタ
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ */
+void SSD1306_DrawStringCached(int16_t x, int16_t y, const char *str, uint8_t color);
+
+/**
+ * @brief キャッシュの統計情報を取得する
+ * @param stats 統計情報の格納先
+ * @note ヒット率 = hits / (hits + misses)
+ */
+void SSD1306_GlyphCache_GetStats(SSD1306_GlyphCacheStats *stats);
+
+/**
+ * @brief キャッシュの統計情報をリセットする
+ */
+void SSD1306_GlyphCache_ResetStats(void);
+
+/**
+ * @brief キャッシュ内の全グリフを破棄する
+ */
+void SSD1306_GlyphCache_Flush(void);
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef __SSD1306_GRAY_H
+#define __SSD1306_GRAY_H
+
+#include <stdint.h>
+
+#include "ssd1306.h"
+
+// Gray levels (0 = off, 3 = full brightness)
+#define SSD1306_GRAY_LEVELS 4
+
+// Frame buffer size: two page-major bit planes (low bit plane first, then high bit plane)
+#define SSD1306_GRAY_BUFFER_SIZE (SSD1306_BUFFER_SIZE * 2)
+
+// 2bpp bitmap size in bytes for SSD1306_Gray_DrawBitmap() (low plane followed by high plane)
+#define SSD1306_GRAY_BITMAP_SIZE(width, height) (2 * (width) * (((height) + 7) / 8))
+
+// Scheduler modes (time slots per cycle and the contrast used in each slot)
+#define SSD1306_GRAY_MODE_TIME 0x00     // 3 slots: high plane, high plane, low plane at one contrast (levels 0, 1/3, 2/3, 1)
+#define SSD1306_GRAY_MODE_CONTRAST 0x01 // 2 slots: high plane at the contrast, low plane at half of it (levels 0, 1/4, 1/2, 3/4)
+
+/**
+ * @brief グレースケール（2ビット/ピクセル）モードを初期化する
+ * @param planes フレームバッファ（SSD1306_GRAY_BUFFER_SIZEバイト、全ピクセルがレベル0に初期化される）
+ * @param mode SSD1306_GRAY_MODE_TIME / SSD1306_GRAY_MODE_CONTRAST
+ * @param contrast 基準のコントラスト値 (0-255)
+ * @note ビットプレーンを時分割で表示して階調を表現する。表示はSSD1306_Gray_Tick()を一定周期で呼び出して行う
+ */
+void SSD1306_Gray_Init(uint8_t *planes, uint8_t mode, uint8_t contrast);
+
+/**
+ * @brief グレースケールモードを終了し、コントラストを基準値に戻す
+ * @note 続けてSSD1306_Update()を呼び出すと描画バッファ（白黒）の表示に戻る
+ */
+void SSD1306_Gray_Stop(void);
+
+/**
+ * @brief 全ピクセルを指定レベルで塗りつぶす
+ * @param level 階調 (0-3)
+ */
+void SSD1306_Gray_Clear(uint8_t level);
+
+/**
+ * @brief 指定座標にピクセルを描画する
+ * @param x X座標（画面座標、画面外の点は描画されない）
+ * @param y Y座標
+ * @param level 階調 (0-3)
+ */
+void SSD1306_Gray_DrawPixel(int16_t x, int16_t y, uint8_t level);
+
+/**
+ * @brief 塗りつぶされた矩形を描画する
+ * @param x 左上角のX座標（画面座標）
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @param level 階調 (0-3)
+ */
+void SSD1306_Gray_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t level);
+
+/**
+ * @brief 2ビット/ピクセルのビットマップを描画する（不透過）
+ * @param x 左上角のX座標（画面座標、画面外にはみ出した部分は描画されない）
+ * @param y 左上角のY座標
+ * @param bitmap ページ形式の下位ビットプレーンに続けて上位ビットプレーン（SSD1306_GRAY_BITMAP_SIZEバイト）
+ * @param width 幅
+ * @param height 高さ
+ */
+void SSD1306_Gray_DrawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height);
+
+/**
+ * @brief 次のタイムスロットのビットプレーンを表示する
+ * @return 表示したスロット番号（0=周期の先頭）
+ * @note タイマー等から一定周期で呼び出す（周期×スロット数が1周期、60Hz以上でちらつきが目立たなくなる）。
+ *       直前のスロットと異なる列範囲だけが転送される
+ */
+uint8_t SSD1306_Gray_Tick(void);
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef __SSD1306_QUEUE_H
+#define __SSD1306_QUEUE_H
+
+#include <stdint.h>
+
+// Number of draw commands the queue holds (power of two, at most 128)
+#ifndef SSD1306_QUEUE_SIZE
+#define SSD1306_QUEUE_SIZE 16
+#endif
+
+// Posting (SSD1306_Queue_*) is lock-free and never blocks: one producer (an interrupt handler, or handlers that
+// cannot preempt each other) writes the ring, the main loop drains it with SSD1306_Queue_Drain() and is the only
+// caller of the drawing functions. A full queue drops the command and counts it.
+
+/**
+ * @brief ピクセルの描画を登録する
+ * @param x X座標
+ * @param y Y座標
+ * @param color 色 (0=消去, 1=点灯, SSD1306_COLOR_INVERT=反転)
+ * @return 1=登録した, 0=キューが満杯（破棄して数える）
+ */
+uint8_t SSD1306_Queue_Pixel(int16_t x, int16_t y, uint8_t color);
+
+/**
+ * @brief 線の描画を登録する
+ * @param x0 始点のX座標
+ * @param y0 始点のY座標
+ * @param x1 終点のX座標
+ * @param y1 終点のY座標
+ * @param color 色
+ * @return 1=登録した, 0=キューが満杯
+ */
+uint8_t SSD1306_Queue_Line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
+
+/**
+ * @brief 矩形（枠）の描画を登録する
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @param color 色
+ * @return 1=登録した, 0=キューが満杯
+ */
+uint8_t SSD1306_Queue_Rect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color);
+
+/**
+ * @brief 塗りつぶし矩形の描画を登録する（バーグラフ・値の消去等）
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ * @param width 幅
+ * @param height 高さ
+ * @param color 色
+ * @return 1=登録した, 0=キューが満杯
+ */
+uint8_t SSD1306_Queue_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color);
+
+/**
+ * @brief 円（枠）の描画を登録する
+ * @param x0 中心のX座標
+ * @param y0 中心のY座標
+ * @param radius 半径
+ * @param color 色
+ * @return 1=登録した, 0=キューが満杯
+ */
+uint8_t SSD1306_Queue_Circle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color);
+
+/**
+ * @brief 塗りつぶし円の描画を登録する
+ * @param x0 中心のX座標
+ * @param y0 中心のY座標
+ * @param radius 半径
+ * @param color 色
+ * @return 1=登録した, 0=キューが満杯
+ */
+uint8_t SSD1306_Queue_FillCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color);
+
+/**
+ * @brief 整数の描画を登録する
+ * @param x 描画開始のX座標
+ * @param y 描画開始のY座標
+ * @param value 値
+ * @param min_digits 最小桁数（不足分は0で埋める、0=埋めない）
+ * @param field_width 描画前に背景色で消去する幅（ピクセル、0=消去しない。桁数が減っても前の値が残らない）
+ * @param color 色 (0=消去, 1=点灯。SSD1306_COLOR_INVERTでは消去しない)
+ * @return 1=登録した, 0=キューが満杯
+ * @note 消去と描画が1つのコマンドなので、途中の状態（消えた値）が表示されることはない
+ */
+uint8_t SSD1306_Queue_Int(int16_t x, int16_t y, int32_t value, uint8_t min_digits, uint8_t field_width, uint8_t color);
+
+/**
+ * @brief 登録された描画コマンドを登録順に実行する（メインループから呼び出す）
+ * @return 実行したコマンド数
+ * @note 呼び出し時点までに登録されたコマンドだけを実行する。描画した範囲はSSD1306_Invalidate()で登録されるため、
+ *       続けてSSD1306_Update()・SSD1306_UpdateDirty()のどちらで転送してもよい
+ */
+uint8_t SSD1306_Queue_Drain(void);
+
+/**
+ * @brief キューが満杯で破棄されたコマンドの累計数を返す
+ * @return 破棄数（65535の次は0に戻る）
+ * @note 前回の値との差で、その間に失われたコマンド数が分かる。増える場合はSSD1306_QUEUE_SIZEを大きくするか、
+ *       ドレインの間隔を短くする
+ */
+uint16_t SSD1306_Queue_Dropped(void);
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef __SSD1306_SPRITE_H
+#define __SSD1306_SPRITE_H
+
+#include <stdint.h>
+
+// Maximum number of registered sprites
+#ifndef SSD1306_SPRITE_MAX
+#define SSD1306_SPRITE_MAX 8
+#endif
+
+// Save-under buffer size in bytes for a sprite of the given size (page-major)
+#define SSD1306_SPRITE_SAVE_SIZE(width, height) ((width) * (((height) + 7) / 8))
+
+// Sprite drawing modes
+#define SSD1306_SPRITE_SAVE_UNDER 0x00 // Save the covered background and restore it when the sprite moves
+#define SSD1306_SPRITE_XOR 0x01        // Toggle pixels; drawing the same image again erases it (no save buffer)
+
+/**
+ * @brief スプライト
+ * @note フィールドはSSD1306_Sprite_*関数で操作する
+ */
+typedef struct
+{
+    const uint8_t *image; // ページ形式の画像
+    const uint8_t *mask;  // ページ形式のマスク（1=不透過、NULLの場合は画像の1のビットのみ描画）
+    uint8_t *save;        // 背景の退避バッファ（SSD1306_SPRITE_SAVE_SIZEバイト、XORモードでは不要）
+    uint8_t width;        // 幅
+    uint8_t height;       // 高さ
+    uint8_t mode;         // SSD1306_SPRITE_SAVE_UNDER / SSD1306_SPRITE_XOR
+    int16_t x, y;         // 次に描画する位置（画面外にはみ出してもよい）
+    uint8_t visible;      // 次に描画するか
+    uint8_t changed;      // 位置・表示・画像が最後の描画から変わったか
+    int16_t drawn_x;      // 最後に描画した位置
+    int16_t drawn_y;
+    uint8_t drawn;        // 最後のSSD1306_Sprite_End()で描画したか
+    uint8_t on_buffer;    // 現在バッファに描画されているか
+} SSD1306_Sprite;
+
+/**
+ * @brief スプライトを初期化する（非表示、位置は0,0）
+ * @param sprite スプライト
+ * @param image ページ形式の画像（マスクを使う場合、マスク外のビットは0にすること）
+ * @param mask ページ形式のマスク（NULL可、XORモードでは無視）
+ * @param save 背景の退避バッファ（SSD1306_SPRITE_SAVE_SIZE(width, height)バイト、XORモードではNULL）
+ * @param width 幅
+ * @param height 高さ
+ * @param mode SSD1306_SPRITE_SAVE_UNDER / SSD1306_SPRITE_XOR
+ */
+void SSD1306_Sprite_Init(SSD1306_Sprite *sprite, const uint8_t *image, const uint8_t *mask, uint8_t *save,
+                         uint8_t width, uint8_t height, uint8_t mode);
+
+/**
+ * @brief スプライトを登録する（登録順に重ねて描画される）
+ * @param sprite スプライト
+ * @return 1=成功, 0=登録数の上限
+ */
+uint8_t SSD1306_Sprite_Register(SSD1306_Sprite *sprite);
+
+/**
+ * @brief スプライトの登録を解除する
+ * @param sprite スプライト
+ * @note 描画中のスプライトは消去される。他のスプライトは次のSSD1306_Sprite_End()で再描画される
+ */
+void SSD1306_Sprite_Unregister(SSD1306_Sprite *sprite);
+
+/**
+ * @brief スプライトの位置を設定する（次のSSD1306_Sprite_End()で反映）
+ * @param sprite スプライト
+ * @param x 左上角のX座標
+ * @param y 左上角のY座標
+ */
+void SSD1306_Sprite_MoveTo(SSD1306_Sprite *sprite, int16_t x, int16_t y);
+
+/**
+ * @brief スプライトの表示・非表示を設定する（次のSSD1306_Sprite_End()で反映）
+ * @param sprite スプライト
+ * @param visible 1=表示, 0=非表示
+ */
+void SSD1306_Sprite_Show(SSD1306_Sprite *sprite, uint8_t visible);
+
+/**
+ * @brief スプライトの画像を差し替える（アニメーション用、大きさは変えられない）
+ * @param sprite スプライト
+ * @param image ページ形式の画像
+ * @param mask ページ形式のマスク（NULL可）
+ */
+void SSD1306_Sprite_SetImage(SSD1306_Sprite *sprite, const uint8_t *image, const uint8_t *mask);
+
+/**
+ * @brief 全スプライトをバッファから消去し、背景を元に戻す
+ * @note スプライトと重なる背景を描き換える前に呼び出す（不要な場合は省略可）
+ */
+void SSD1306_Sprite_Begin(void);
+
+/**
+ * @brief 全スプライトを現在の位置に描画し、変化した領域をSSD1306_Invalidate()に登録する
+ * @note 移動したスプライトは旧位置と新位置の矩形だけが登録される。続けてSSD1306_UpdateDirty()で転送する
+ */
+void SSD1306_Sprite_End(void);
+
+#endif
@@ -0,0 +1,113 @@
+// Host benchmark of the animation player: plays a binary stream from tools/animc.py (-b) on the emulator
+// and reports bytes per frame and the frame rate the simulated I2C bus allows
+//
+//   gcc -O2 -Iinclude -Iport/linux -o anim_bench port/linux/anim_bench.c port/linux/ssd1306_emu.c
+//       src/ssd1306.c src/ssd1306_anim.c
+//   ./anim_bench clip.ssda [bus_hz] [loops]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "ssd1306.h"
+#include "ssd1306_anim.h"
+#include "ssd1306_emu.h"
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Load a stream written by animc.py --binary: "SSDA", width, height, frame_count, interval, loop_offset, size, data
+static uint8_t load_stream(const char *path, SSD1306_Animation *anim)
+{
+    uint8_t header[18];
+    FILE *f = fopen(path, "rb");
+
+    if (f == NULL)
+    {
+        return 0;
+    }
+    if (fread(header, 1, sizeof(header), f) != sizeof(header) || memcmp(header, "SSDA", 4) != 0)
+    {
+        fclose(f);
+        return 0;
+    }
+
+    uint8_t *data = malloc(read_u32(&header[14]));
+    anim->width = header[4];
+    anim->height = header[5];
+    anim->frame_count = read_u16(&header[6]);
+    anim->frame_interval = read_u16(&header[8]);
+    anim->loop_offset = read_u32(&header[10]);
+    anim->size = read_u32(&header[14]);
+    anim->data = data;
+
+    uint8_t ok = data != NULL && fread(data, 1, anim->size, f) == anim->size;
+    fclose(f);
+    return ok;
+}
+
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char **argv)
+{
+    SSD1306_Animation anim;
+    SSD1306_AnimPlayer player;
+    SSD1306_EmuStats start, end;
+    uint32_t bus_hz = (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 0) : 400000;
+    uint32_t loops = (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 0) : 1;
+
+    if (argc < 2 || !load_stream(argv[1], &anim))
+    {
+        fprintf(stderr, "usage: %s stream.ssda [bus_hz] [loops]\n", argv[0]);
+        return 1;
+    }
+
+    SSD1306_Init();
+    SSD1306_Emu_SetBusClock(bus_hz);
+    SSD1306_Emu_GetStats(&start);
+
+    // Loops after the first replay from loop_offset, one-shot streams are simply restarted
+    uint32_t frames = 0;
+    double cpu_us = 0;
+    SSD1306_Anim_Start(&player, &anim);
+    for (uint32_t pass = 0; pass < loops; pass++)
+    {
+        uint16_t count = (pass == 0 || anim.loop_offset == 0) ? anim.frame_count : anim.frame_count - 1;
+        if (anim.loop_offset == 0)
+            SSD1306_Anim_Start(&player, &anim);
+
+        for (uint16_t i = 0; i < count; i++)
+        {
+            double t0 = now_us();
+            SSD1306_Anim_NextFrame(&player, (SSD1306_WIDTH - anim.width) / 2, (SSD1306_HEIGHT - anim.height) / 2);
+            SSD1306_UpdateDirty();
+            cpu_us += now_us() - t0;
+            frames++;
+        }
+    }
+    SSD1306_Emu_GetStats(&end);
+
+    double bus_us = (double)(end.bus_time_us - start.bus_time_us) / frames;
+    printf("%s: %ux%u, %u frames played, stream %.1f bytes/frame (raw %u)\n", argv[1], anim.width, anim.height,
+           frames, (double)anim.size / anim.frame_count, anim.width * ((anim.height + 7) / 8));
+    printf("bus: %.1f data + %.1f command bytes/frame, %.1f transactions/frame\n",
+           (double)(end.data_bytes - start.data_bytes) / frames,
+           (double)(end.command_bytes - start.command_bytes) / frames,
+           (double)(end.transactions - start.transactions) / frames);
+    printf("bus time %.0f us/frame at %u Hz -> %.0f fps max (stream rate %.1f fps), host decode+diff %.2f us/frame\n",
+           bus_us, bus_hz, bus_us > 0 ? 1e6 / bus_us : 0.0, 1000.0 / anim.frame_interval, cpu_us / frames);
+    return 0;
+}
@@ -0,0 +1,194 @@
+// Host check of the outline primitives under SSD1306_COLOR_INVERT: random arcs and needles must light the same
+// pixels as with color 1, triangles each side without its end pixel, and drawing the same shape again must
+// restore the blank buffer
+//
+//   gcc -O2 -Iinclude -Iport/linux -o draw_check port/linux/draw_check.c port/linux/ssd1306_emu.c src/ssd1306.c
+//   ./draw_check [shapes] [seed]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+#define FRAME_BYTES (128 * 64 / 8)
+
+enum
+{
+    SHAPE_ARC,
+    SHAPE_NEEDLE,
+    SHAPE_TRIANGLE,
+    SHAPE_COUNT
+};
+
+static const char *const shape_names[SHAPE_COUNT] = {"DrawArc", "DrawNeedle", "DrawTriangle"};
+
+typedef struct
+{
+    int16_t x[3], y[3];
+    uint8_t radius, length, width;
+    int16_t angle0, angle1;
+} shape_t;
+
+static int16_t random_range(int16_t lo, int16_t hi)
+{
+    return (int16_t)(lo + rand() % (hi - lo + 1));
+}
+
+static void random_shape(shape_t *s)
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        s->x[i] = random_range(-20, 147);
+        s->y[i] = random_range(-20, 83);
+    }
+    s->radius = (uint8_t)random_range(0, 40);
+    s->length = (uint8_t)random_range(0, 40);
+    s->width = (uint8_t)random_range(0, 9);
+    s->angle0 = random_range(-SSD1306_ANGLE_FULL, SSD1306_ANGLE_FULL);
+    s->angle1 = (rand() % 8) ? random_range(-SSD1306_ANGLE_FULL, 2 * SSD1306_ANGLE_FULL)
+                             : s->angle0 + (rand() % 9) * (SSD1306_ANGLE_FULL / 8); // Octant boundaries
+}
+
+static void draw_shape(uint8_t kind, const shape_t *s, uint8_t color)
+{
+    switch (kind)
+    {
+    case SHAPE_ARC:
+        SSD1306_DrawArc(s->x[0], s->y[0], s->radius, s->angle0, s->angle1, color);
+        break;
+    case SHAPE_NEEDLE:
+        SSD1306_DrawNeedle(s->x[0], s->y[0], s->length, s->width, s->angle0, color);
+        break;
+    default:
+        SSD1306_DrawTriangle(s->x[0], s->y[0], s->x[1], s->y[1], s->x[2], s->y[2], color);
+        break;
+    }
+}
+
+// The same pixels as drawn with color 1, from the separate parts the shape is made of
+static void draw_reference(uint8_t kind, const shape_t *s)
+{
+    int16_t tip_x, tip_y, lx, ly, rx, ry;
+
+    switch (kind)
+    {
+    case SHAPE_NEEDLE:
+        if (s->width <= 1)
+        {
+            SSD1306_DrawNeedle(s->x[0], s->y[0], s->length, s->width, s->angle0, 1);
+            break;
+        }
+        SSD1306_PolarPoint(s->x[0], s->y[0], s->length, s->angle0, &tip_x, &tip_y);
+        SSD1306_PolarPoint(s->x[0], s->y[0], s->width >> 1, s->angle0 - SSD1306_ANGLE_FULL / 4, &lx, &ly);
+        SSD1306_PolarPoint(s->x[0], s->y[0], s->width >> 1, s->angle0 + SSD1306_ANGLE_FULL / 4, &rx, &ry);
+        SSD1306_FillTriangle(lx, ly, rx, ry, tip_x, tip_y, 1);
+        SSD1306_DrawLine(s->x[0], s->y[0], tip_x, tip_y, 1);
+        break;
+    case SHAPE_TRIANGLE:
+        SSD1306_DrawLine(s->x[0], s->y[0], s->x[1], s->y[1], 1);
+        SSD1306_DrawLine(s->x[1], s->y[1], s->x[2], s->y[2], 1);
+        SSD1306_DrawLine(s->x[2], s->y[2], s->x[0], s->y[0], 1);
+        break;
+    default:
+        if (s->angle1 - s->angle0 >= SSD1306_ANGLE_FULL || s->angle1 - s->angle0 <= -SSD1306_ANGLE_FULL)
+            SSD1306_DrawCircle(s->x[0], s->y[0], s->radius, 1);
+        else
+            SSD1306_DrawArc(s->x[0], s->y[0], s->radius, s->angle0, s->angle1, 1);
+        break;
+    }
+}
+
+// What INVERT leaves on a blank buffer: arcs and needles toggle each pixel once, a triangle toggles each side
+// without its end pixel (the three full sides toggle every vertex twice, one more toggle per vertex corrects that)
+static void draw_inverted_reference(uint8_t kind, const shape_t *s)
+{
+    if (kind != SHAPE_TRIANGLE)
+    {
+        draw_reference(kind, s);
+        return;
+    }
+    if (s->x[0] == s->x[1] && s->x[1] == s->x[2] && s->y[0] == s->y[1] && s->y[1] == s->y[2])
+    {
+        SSD1306_DrawPixel(s->x[0], s->y[0], 1); // A single point
+        return;
+    }
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        uint8_t j = (uint8_t)((i + 1) % 3);
+        SSD1306_DrawLine(s->x[i], s->y[i], s->x[j], s->y[j], SSD1306_COLOR_INVERT);
+        SSD1306_DrawPixel(s->x[j], s->y[j], SSD1306_COLOR_INVERT);
+    }
+}
+
+static void read_frame(uint8_t *frame)
+{
+    SSD1306_ReadBitmap(0, 0, frame, 128, 64);
+}
+
+static uint32_t count_pixels(const uint8_t *frame)
+{
+    uint32_t count = 0;
+
+    for (uint16_t i = 0; i < FRAME_BYTES; i++)
+        count += (uint32_t)__builtin_popcount(frame[i]);
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t shapes = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000;
+    uint32_t failures[SHAPE_COUNT] = {0};
+    uint32_t pixels[SHAPE_COUNT] = {0};
+
+    srand((argc > 2) ? (unsigned)strtoul(argv[2], NULL, 0) : 1);
+    SSD1306_Init();
+
+    for (uint32_t i = 0; i < shapes; i++)
+    {
+        uint8_t kind = (uint8_t)(i % SHAPE_COUNT);
+        uint8_t solid[FRAME_BYTES], reference[FRAME_BYTES];
+        uint8_t inverted[FRAME_BYTES], inverted_reference[FRAME_BYTES], restored[FRAME_BYTES];
+        static const uint8_t blank[FRAME_BYTES];
+        shape_t s;
+        random_shape(&s);
+        SSD1306_SetOrigin(random_range(-8, 8), random_range(-8, 8));
+
+        SSD1306_Clear();
+        draw_shape(kind, &s, 1);
+        read_frame(solid);
+
+        SSD1306_Clear();
+        draw_reference(kind, &s);
+        read_frame(reference);
+
+        SSD1306_Clear();
+        draw_inverted_reference(kind, &s);
+        read_frame(inverted_reference);
+
+        SSD1306_Clear();
+        draw_shape(kind, &s, SSD1306_COLOR_INVERT);
+        read_frame(inverted);
+        draw_shape(kind, &s, SSD1306_COLOR_INVERT);
+        read_frame(restored);
+
+        pixels[kind] += count_pixels(solid);
+        if (memcmp(solid, reference, FRAME_BYTES) != 0 || memcmp(inverted, inverted_reference, FRAME_BYTES) != 0 ||
+            memcmp(restored, blank, FRAME_BYTES) != 0)
+        {
+            if (failures[kind]++ == 0)
+                printf("%s: first failure at shape %u (solid %u/%u, inverted %u/%u, left after twice %u pixels)\n",
+                       shape_names[kind], i, count_pixels(solid), count_pixels(reference), count_pixels(inverted),
+                       count_pixels(inverted_reference), count_pixels(restored));
+        }
+    }
+
+    uint32_t total = 0;
+    for (uint8_t kind = 0; kind < SHAPE_COUNT; kind++)
+    {
+        printf("%-13s %u failures, %u pixels\n", shape_names[kind], failures[kind], pixels[kind]);
+        total += failures[kind];
+    }
+    return total != 0;
+}
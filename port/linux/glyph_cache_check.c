@@ -0,0 +1,140 @@
+// Host check of the glyph cache: builds a proportional font in memory, writes the same glyphs as an "SGF1"
+// image (the tools/fontc.py -f bin layout), and compares SSD1306_DrawStringCached() with
+// SSD1306_DrawStringFont() on random strings, positions and origins, line wrap included
+//
+//   gcc -O2 -Iinclude -Iport/linux -o glyph_cache_check port/linux/glyph_cache_check.c port/linux/ssd1306_emu.c
+//       src/ssd1306.c src/ssd1306_glyph_cache.c
+//   ./glyph_cache_check [strings] [seed]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_glyph_cache.h"
+#include "ssd1306_emu.h"
+
+#define FIRST_CODEPOINT 0x20
+#define LAST_CODEPOINT 0x7E
+#define FONT_HEIGHT 12
+#define FONT_PAGES ((FONT_HEIGHT + 7) / 8)
+#define MAX_GLYPHS (LAST_CODEPOINT - FIRST_CODEPOINT + 1)
+
+static SSD1306_FontGlyph glyphs[MAX_GLYPHS];
+static uint8_t bitmaps[MAX_GLYPHS * 8 * FONT_PAGES];
+static SSD1306_Font font = {bitmaps, glyphs, 0, FONT_HEIGHT, 10, FONT_HEIGHT + 1, 5};
+
+static uint8_t image[SSD1306_GLYPH_IMAGE_HEADER_SIZE + MAX_GLYPHS * SSD1306_GLYPH_IMAGE_ENTRY_SIZE + sizeof(bitmaps)];
+
+static void put_u16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t value)
+{
+    put_u16(p, (uint16_t)value);
+    put_u16(p + 2, (uint16_t)(value >> 16));
+}
+
+// Random glyphs 1-8 pixels wide; every seventh code point is left out to exercise the missing-glyph advance
+static void build_font(void)
+{
+    uint16_t offset = 0;
+    uint16_t count = 0;
+
+    for (uint16_t codepoint = FIRST_CODEPOINT; codepoint <= LAST_CODEPOINT; codepoint++)
+    {
+        if (codepoint % 7 == 0)
+            continue;
+
+        SSD1306_FontGlyph *glyph = &glyphs[count++];
+        glyph->codepoint = codepoint;
+        glyph->offset = offset;
+        glyph->width = (uint8_t)(1 + rand() % 8);
+        glyph->advance = (uint8_t)(glyph->width + rand() % 3);
+        for (uint8_t i = 0; i < glyph->width * FONT_PAGES; i++)
+            bitmaps[offset++] = (uint8_t)rand();
+    }
+    font.glyph_count = count;
+
+    // Header, index, bitmaps: the layout tools/fontc.py writes with -f bin
+    uint32_t data_start = SSD1306_GLYPH_IMAGE_HEADER_SIZE + (uint32_t)count * SSD1306_GLYPH_IMAGE_ENTRY_SIZE;
+    memcpy(image, "SGF1", 4);
+    put_u16(&image[4], count);
+    image[6] = font.height;
+    image[7] = font.baseline;
+    image[8] = font.line_height;
+    image[9] = font.default_advance;
+    put_u16(&image[10], 0);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        uint8_t *entry = &image[SSD1306_GLYPH_IMAGE_HEADER_SIZE + i * SSD1306_GLYPH_IMAGE_ENTRY_SIZE];
+        put_u16(&entry[0], glyphs[i].codepoint);
+        entry[2] = glyphs[i].width;
+        entry[3] = glyphs[i].advance;
+        put_u32(&entry[4], data_start + glyphs[i].offset);
+    }
+    memcpy(&image[data_start], bitmaps, offset);
+}
+
+static void read_image(uint32_t address, uint8_t *data, uint16_t length)
+{
+    memcpy(data, &image[address], length);
+}
+
+static int16_t random_range(int16_t lo, int16_t hi)
+{
+    return (int16_t)(lo + rand() % (hi - lo + 1));
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t strings = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 5000;
+    uint32_t failures = 0;
+    uint32_t with_origin = 0;
+    uint8_t in_flash[SSD1306_BUFFER_SIZE], cached[SSD1306_BUFFER_SIZE];
+
+    srand((argc > 2) ? (unsigned)strtoul(argv[2], NULL, 0) : 1);
+    build_font();
+    SSD1306_Init();
+    if (!SSD1306_GlyphCache_Init(read_image, 0, NULL))
+    {
+        printf("glyph image not recognized\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < strings; i++)
+    {
+        char str[64];
+        uint8_t length = (uint8_t)random_range(1, sizeof(str) - 1);
+        for (uint8_t k = 0; k < length; k++)
+            str[k] = (char)random_range(FIRST_CODEPOINT, LAST_CODEPOINT);
+        str[length] = 0;
+
+        int16_t x = random_range(-20, SSD1306_WIDTH);
+        int16_t y = random_range(-20, SSD1306_HEIGHT);
+        int16_t origin_x = (i % 4) ? random_range(-30, 60) : 0;
+        int16_t origin_y = (i % 4) ? random_range(-20, 30) : 0;
+        with_origin += (origin_x != 0 || origin_y != 0);
+        SSD1306_SetOrigin(origin_x, origin_y);
+
+        SSD1306_Clear();
+        SSD1306_DrawStringFont(x, y, &font, str, 1);
+        SSD1306_ReadBitmap(0, 0, in_flash, SSD1306_WIDTH, SSD1306_HEIGHT);
+
+        SSD1306_Clear();
+        SSD1306_DrawStringCached(x, y, str, 1);
+        SSD1306_ReadBitmap(0, 0, cached, SSD1306_WIDTH, SSD1306_HEIGHT);
+
+        if (memcmp(in_flash, cached, sizeof(cached)) != 0 && failures++ < 5)
+            printf("string %u at (%d, %d), origin (%d, %d): cached render differs\n", i, x, y, origin_x, origin_y);
+    }
+
+    SSD1306_GlyphCacheStats stats;
+    SSD1306_GlyphCache_GetStats(&stats);
+    printf("%u strings (%u with an origin), %u hits, %u misses: %u differ\n", strings, with_origin, stats.hits,
+           stats.misses, failures);
+    return failures != 0;
+}
@@ -0,0 +1,108 @@
+// Host check of the grayscale mode: fills four level bands, integrates whole SSD1306_Gray_Tick() cycles on the
+// emulator and checks the brightness of each level, then checks that SSD1306_Gray_Stop() + SSD1306_Update()
+// bring back the monochrome draw buffer at the base contrast
+//
+//   gcc -O2 -Iinclude -Iport/linux -o gray_check port/linux/gray_check.c port/linux/ssd1306_emu.c src/ssd1306.c
+//       src/ssd1306_gray.c
+//   ./gray_check [cycles] [gray.pgm]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_gray.h"
+#include "ssd1306_emu.h"
+
+#define BAND_WIDTH (SSD1306_WIDTH / SSD1306_GRAY_LEVELS)
+#define CONTRAST 0xFF
+
+static uint8_t planes[SSD1306_GRAY_BUFFER_SIZE];
+static uint32_t accumulator[SSD1306_WIDTH * SSD1306_HEIGHT];
+static uint32_t failures;
+
+// Brightness of each level averaged over a cycle (a lit pixel integrates to contrast + 1 per slot)
+static const uint16_t time_levels[SSD1306_GRAY_LEVELS] = {0, (CONTRAST + 1) / 3, 2 * (CONTRAST + 1) / 3, CONTRAST + 1};
+static const uint16_t contrast_levels[SSD1306_GRAY_LEVELS] = {0, (CONTRAST + 1) / 4, (CONTRAST + 1) / 2,
+                                                              3 * (CONTRAST + 1) / 4};
+
+static void run(const char *name, uint8_t mode, uint8_t slots, const uint16_t *expected, uint32_t cycles,
+                const char *pgm)
+{
+    uint32_t failures_before = failures;
+    uint16_t measured[SSD1306_GRAY_LEVELS] = {0};
+
+    // Monochrome content to come back to after the grayscale mode
+    SSD1306_Clear();
+    SSD1306_DrawString(4, 28, "MONO", 1);
+    SSD1306_FillRect(96, 8, 24, 48, 1);
+    SSD1306_Update();
+
+    SSD1306_Gray_Init(planes, mode, CONTRAST);
+    for (uint8_t level = 0; level < SSD1306_GRAY_LEVELS; level++)
+        SSD1306_Gray_FillRect(level * BAND_WIDTH, 0, BAND_WIDTH, SSD1306_HEIGHT, level);
+
+    // Start at the first slot of a cycle, then integrate whole cycles
+    while (SSD1306_Gray_Tick() != slots - 1)
+        ;
+    memset(accumulator, 0, sizeof(accumulator));
+    for (uint32_t tick = 0; tick < cycles * slots; tick++)
+    {
+        SSD1306_Gray_Tick();
+        SSD1306_Emu_Integrate(accumulator, 1);
+    }
+    if (pgm)
+        SSD1306_Emu_WritePGM(pgm, accumulator, cycles * slots);
+
+    for (uint16_t i = 0; i < SSD1306_WIDTH * SSD1306_HEIGHT; i++)
+    {
+        uint8_t level = (uint8_t)(i % SSD1306_WIDTH / BAND_WIDTH);
+        uint16_t brightness = (uint16_t)(accumulator[i] / (cycles * slots));
+
+        measured[level] = brightness;
+        if (brightness != expected[level] && failures++ < 8)
+            printf("%s: pixel (%u, %u) level %u integrates to %u, expected %u\n", name, i % SSD1306_WIDTH,
+                   i / SSD1306_WIDTH, level, brightness, expected[level]);
+    }
+
+    // Back to monochrome: the draw buffer on the panel, lit pixels at the base contrast
+    uint8_t frame[SSD1306_BUFFER_SIZE];
+    SSD1306_Gray_Stop();
+    SSD1306_Update();
+    SSD1306_ReadBitmap(0, 0, frame, SSD1306_WIDTH, SSD1306_HEIGHT);
+    if (memcmp(SSD1306_Emu_GDDRAM(), frame, sizeof(frame)) != 0 && failures++ < 8)
+        printf("%s: GDDRAM after Gray_Stop + Update differs from the draw buffer\n", name);
+
+    memset(accumulator, 0, sizeof(accumulator));
+    SSD1306_Emu_Integrate(accumulator, 1);
+    for (uint16_t i = 0; i < SSD1306_WIDTH * SSD1306_HEIGHT; i++)
+    {
+        uint16_t x = i % SSD1306_WIDTH;
+        uint16_t y = i / SSD1306_WIDTH;
+        uint32_t lit = (frame[(y >> 3) * SSD1306_WIDTH + x] >> (y & 7)) & 1;
+
+        if (accumulator[i] != lit * (CONTRAST + 1) && failures++ < 8)
+        {
+            printf("%s: pixel (%u, %u) shows %u after Gray_Stop, expected %u\n", name, x, y, accumulator[i],
+                   lit * (CONTRAST + 1));
+            break;
+        }
+    }
+
+    printf("%-9s levels %u/%u/%u/%u over %u cycles: %s\n", name, measured[0], measured[1], measured[2], measured[3],
+           cycles, (failures == failures_before) ? "ok" : "FAILED");
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t cycles = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20;
+    const char *pgm = (argc > 2) ? argv[2] : NULL;
+
+    if (cycles == 0)
+        cycles = 1;
+    SSD1306_Init();
+
+    run("TIME", SSD1306_GRAY_MODE_TIME, 3, time_levels, cycles, pgm);
+    run("CONTRAST", SSD1306_GRAY_MODE_CONTRAST, 2, contrast_levels, cycles, NULL);
+    return failures != 0;
+}
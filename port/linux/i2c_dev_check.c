@@ -0,0 +1,182 @@
+// Host check of the i2c-dev HAL without hardware: a mock ioctl() records what ssd1306_i2c_dev.c submits and
+// checks one I2C_RDWR per update, the control bytes, and the SMBus block split on SMBus-only adapters (the
+// SSD1306_InitFast() command sequence included)
+//
+//   gcc -O2 -Iinclude -Iport/linux -o i2c_dev_check port/linux/i2c_dev_check.c port/linux/ssd1306_i2c_dev.c
+//       src/ssd1306.c
+//   ./i2c_dev_check
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "ssd1306.h"
+#include "ssd1306_i2c_dev.h"
+
+#define CHECK_ADDRESS 0x3D
+
+// What the mock adapter reports and what it has seen
+static unsigned long adapter_funcs;
+static uint8_t fail_next;
+static uint32_t rdwr_calls;
+static uint32_t smbus_calls;
+static uint32_t data_bytes; // Payload bytes sent with the data control byte (0x40)
+static uint8_t longest_command; // Longest SMBus command block
+static uint32_t failures;
+
+static void fail(const char *what, unsigned value)
+{
+    if (failures++ < 8)
+        printf("%s (%u)\n", what, value);
+}
+
+static void check_control(uint8_t control)
+{
+    if (control != SSD1306_MODE_COMMAND && control != SSD1306_MODE_DATA)
+        fail("control byte is neither 0x00 nor 0x40", control);
+}
+
+static int mock_ioctl(int fd, unsigned long request, void *arg)
+{
+    (void)fd;
+
+    if (fail_next)
+    {
+        fail_next = 0;
+        return -1;
+    }
+
+    switch (request)
+    {
+    case I2C_FUNCS:
+        *(unsigned long *)arg = adapter_funcs;
+        return 0;
+
+    case I2C_SLAVE:
+        if ((unsigned long)arg != CHECK_ADDRESS)
+            fail("I2C_SLAVE with the wrong address", (unsigned)(unsigned long)arg);
+        return 0;
+
+    case I2C_RDWR:
+    {
+        const struct i2c_rdwr_ioctl_data *rdwr = arg;
+
+        rdwr_calls++;
+        if (!(adapter_funcs & I2C_FUNC_I2C))
+            fail("I2C_RDWR on an SMBus-only adapter", rdwr->nmsgs);
+        for (uint32_t i = 0; i < rdwr->nmsgs; i++)
+        {
+            const struct i2c_msg *msg = &rdwr->msgs[i];
+
+            if (msg->addr != CHECK_ADDRESS || msg->flags != 0 || msg->len < 2)
+                fail("message with the wrong address, flags or length", msg->len);
+            check_control(msg->buf[0]);
+            if (msg->buf[0] == SSD1306_MODE_DATA)
+                data_bytes += msg->len - 1u;
+        }
+        return 0;
+    }
+
+    case I2C_SMBUS:
+    {
+        const struct i2c_smbus_ioctl_data *smbus = arg;
+        uint8_t length = smbus->data->block[0];
+
+        smbus_calls++;
+        if (smbus->read_write != I2C_SMBUS_WRITE || smbus->size != I2C_SMBUS_I2C_BLOCK_DATA)
+            fail("SMBus transfer that is not an I2C block write", smbus->size);
+        if (length < 1 || length > I2C_SMBUS_BLOCK_MAX)
+            fail("SMBus block length outside 1-32", length);
+        check_control(smbus->command);
+        if (smbus->command == SSD1306_MODE_DATA)
+            data_bytes += length;
+        else if (length > longest_command)
+            longest_command = length;
+        return 0;
+    }
+
+    default:
+        fail("unexpected ioctl", (unsigned)request);
+        return -1;
+    }
+}
+
+// Random rectangles, so every update has something to send
+static void draw_something(void)
+{
+    SSD1306_FillRect((int16_t)(rand() % 128), (int16_t)(rand() % 64), (uint8_t)(1 + rand() % 40),
+                     (uint8_t)(1 + rand() % 40), SSD1306_COLOR_INVERT);
+}
+
+static void run(const char *name, unsigned long funcs)
+{
+    SSD1306_I2CDevStats stats;
+    uint32_t failures_before = failures;
+
+    adapter_funcs = funcs;
+    SSD1306_I2CDev_Config("/dev/null", CHECK_ADDRESS);
+
+    // The fast start-up: one command transaction longer than an SMBus block, then the whole GDDRAM
+    rdwr_calls = smbus_calls = data_bytes = longest_command = 0;
+    SSD1306_InitFast(NULL);
+    if (data_bytes != SSD1306_BUFFER_SIZE)
+        fail("InitFast did not write 1024 data bytes", data_bytes);
+    if (!(funcs & I2C_FUNC_I2C) && longest_command != I2C_SMBUS_BLOCK_MAX)
+        fail("InitFast command sequence not split at a full SMBus block", longest_command);
+
+    SSD1306_Init();
+
+    // A full frame: 1024 data bytes, in blocks of at most 32 on SMBus
+    rdwr_calls = smbus_calls = data_bytes = 0;
+    SSD1306_Update_Full();
+    if (data_bytes != SSD1306_BUFFER_SIZE)
+        fail("Update_Full did not send 1024 data bytes", data_bytes);
+    if ((funcs & I2C_FUNC_I2C) && rdwr_calls != 1)
+        fail("Update_Full did not take one I2C_RDWR", rdwr_calls);
+    if (!(funcs & I2C_FUNC_I2C) && smbus_calls < SSD1306_BUFFER_SIZE / I2C_SMBUS_BLOCK_MAX)
+        fail("Update_Full took fewer SMBus blocks than 1024 bytes need", smbus_calls);
+
+    for (uint16_t i = 0; i < 2000; i++)
+    {
+        for (uint8_t n = (uint8_t)(1 + rand() % 4); n; n--)
+            draw_something();
+        if (rand() % 8 == 0)
+            SSD1306_SetContrast((uint8_t)rand()); // Queued settings go out in the same batch
+
+        rdwr_calls = 0;
+        SSD1306_Update();
+        if ((funcs & I2C_FUNC_I2C) && rdwr_calls != 1)
+            fail("SSD1306_Update() did not take exactly one I2C_RDWR", rdwr_calls);
+    }
+
+    // A failed ioctl loses that update only
+    SSD1306_I2CDev_GetStats(&stats);
+    uint32_t errors = stats.errors;
+    draw_something();
+    fail_next = 1;
+    SSD1306_Update();
+    SSD1306_I2CDev_GetStats(&stats);
+    if (stats.errors != errors + 1)
+        fail("failed ioctl not counted", stats.errors - errors);
+    draw_something();
+    rdwr_calls = smbus_calls = 0;
+    SSD1306_Update();
+    if (rdwr_calls + smbus_calls == 0)
+        fail("nothing sent after a failed ioctl", 0);
+
+    SSD1306_I2CDev_GetStats(&stats);
+    printf("%-11s %u ioctls, %u transactions, %u bytes, %u errors: %s\n", name, stats.ioctls, stats.transactions,
+           stats.bytes, stats.errors, (failures == failures_before) ? "ok" : "FAILED");
+}
+
+int main(void)
+{
+    srand(48);
+    SSD1306_I2CDev_SetIoctl(mock_ioctl);
+
+    run("I2C_RDWR", I2C_FUNC_I2C | I2C_FUNC_SMBUS_WRITE_I2C_BLOCK);
+    run("SMBus only", I2C_FUNC_SMBUS_WRITE_I2C_BLOCK);
+    return failures != 0;
+}
@@ -0,0 +1,71 @@
+// Host benchmark of the time to first pixel: runs SSD1306_Init() and SSD1306_InitFast() on the emulator and
+// reports the simulated bus time plus the time spent in SSD1306_Delay_Ms_HAL() until the first frame is lit
+//
+//   gcc -O2 -Iinclude -Iport/linux -o init_bench port/linux/init_bench.c port/linux/ssd1306_emu.c src/ssd1306.c
+//   ./init_bench [bus_hz]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "image_sample.h"
+
+static void show_splash(void)
+{
+    SSD1306_DrawImage((SSD1306_WIDTH - image_sample.width) / 2, (SSD1306_HEIGHT - image_sample.height) / 2,
+                      &image_sample, SSD1306_BLIT_OPAQUE);
+    SSD1306_Update();
+}
+
+static void init_splash(void)
+{
+    SSD1306_Init();
+    show_splash();
+}
+
+static void init_fast(void)
+{
+    SSD1306_InitFast(NULL);
+}
+
+static void init_fast_splash(void)
+{
+    SSD1306_InitFast(&image_sample);
+}
+
+// Run one start-up sequence on a freshly powered emulator and print its time to first pixel
+static void measure(const char *name, void (*start)(void), uint32_t bus_hz, uint8_t *gddram)
+{
+    SSD1306_EmuStats stats;
+
+    SSD1306_Emu_Reset();
+    SSD1306_Emu_SetBusClock(bus_hz);
+    start();
+    SSD1306_Emu_GetStats(&stats);
+    memcpy(gddram, SSD1306_Emu_GDDRAM(), SSD1306_BUFFER_SIZE);
+
+    printf("%-26s %3u transactions, bus %7.2f ms + delay %6.2f ms = %7.2f ms\n", name, stats.transactions,
+           stats.bus_time_us / 1000.0, stats.delay_time_us / 1000.0,
+           (stats.bus_time_us + stats.delay_time_us) / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t bus_hz = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 400000;
+    uint8_t blank[SSD1306_BUFFER_SIZE], splash[SSD1306_BUFFER_SIZE];
+    uint8_t fast_blank[SSD1306_BUFFER_SIZE], fast_splash[SSD1306_BUFFER_SIZE];
+
+    printf("time to first pixel at %u Hz\n", bus_hz);
+    measure("SSD1306_Init", SSD1306_Init, bus_hz, blank);
+    measure("SSD1306_Init + splash", init_splash, bus_hz, splash);
+    measure("SSD1306_InitFast(NULL)", init_fast, bus_hz, fast_blank);
+    measure("SSD1306_InitFast(splash)", init_fast_splash, bus_hz, fast_splash);
+
+    // Both start-ups must leave the same picture on the panel
+    uint8_t same = memcmp(blank, fast_blank, SSD1306_BUFFER_SIZE) == 0 &&
+                   memcmp(splash, fast_splash, SSD1306_BUFFER_SIZE) == 0;
+    printf("GDDRAM after InitFast %s the one after Init\n", same ? "matches" : "DIFFERS from");
+    return !same;
+}
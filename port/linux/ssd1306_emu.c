@@ -0,0 +1,351 @@
+// Host emulator of the SSD1306 behind the I2C HAL (see ssd1306_emu.h)
+// Segment remap and COM scan direction are not applied: the image is kept in frame buffer orientation
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_HAL.h"
+#include "ssd1306_emu.h"
+
+#define EMU_PAGES (SSD1306_HEIGHT / 8)
+
+static uint8_t gddram[SSD1306_BUFFER_SIZE];
+
+static uint8_t addressing_mode; // 0 = horizontal, 1 = vertical, 2 = page
+static uint8_t col_start, col_end, page_start, page_end;
+static uint8_t col, page;
+static uint8_t contrast;
+static uint8_t display_on;
+static uint8_t all_on;
+static uint8_t inverse;
+static uint8_t start_line;
+static uint8_t display_offset;
+
+// Command being collected across bytes (and across transactions, as on the real controller)
+static uint8_t cmd_bytes[8];
+static uint8_t cmd_length;
+static uint8_t cmd_expected;
+
+static uint32_t bus_clock_hz = 400000;
+static SSD1306_EmuStats stats;
+
+// Packet started by SSD1306_IIC_Packet_Start_HAL() in asynchronous mode, read only when it completes
+static uint8_t async_mode;
+static uint8_t *in_flight;
+static uint16_t in_flight_length;
+
+void SSD1306_Emu_Reset(void)
+{
+    memset(gddram, 0, sizeof(gddram));
+    addressing_mode = 2; // Page addressing after reset
+    col_start = 0;
+    col_end = SSD1306_WIDTH - 1;
+    page_start = 0;
+    page_end = EMU_PAGES - 1;
+    col = 0;
+    page = 0;
+    contrast = 0x7F;
+    display_on = 0;
+    all_on = 0;
+    inverse = 0;
+    start_line = 0;
+    display_offset = 0;
+    cmd_length = 0;
+    cmd_expected = 0;
+    in_flight = 0;
+    memset(&stats, 0, sizeof(stats));
+}
+
+void SSD1306_Emu_SetBusClock(uint32_t hz)
+{
+    bus_clock_hz = hz;
+}
+
+void SSD1306_Emu_GetStats(SSD1306_EmuStats *out)
+{
+    *out = stats;
+}
+
+const uint8_t *SSD1306_Emu_GDDRAM(void)
+{
+    return gddram;
+}
+
+// Number of argument bytes that follow a command byte
+static uint8_t command_arguments(uint8_t cmd)
+{
+    switch (cmd)
+    {
+    case SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE:
+    case SSD1306_CMD_SET_CONTRAST:
+    case SSD1306_CMD_SET_CHARGE_PUMP:
+    case SSD1306_CMD_SET_MULTIPLEX_RATIO:
+    case SSD1306_CMD_SET_DISPLAY_OFFSET:
+    case SSD1306_CMD_SET_DISPLAY_CLOCK_DIVIDE_RATIO:
+    case 0xD8: // Color mode / low power (SSD1306B)
+    case SSD1306_CMD_SET_PRECHARGE_PERIOD:
+    case SSD1306_CMD_SET_COM_PINS_HARDWARE_CONFIGURATION:
+    case SSD1306_CMD_SET_VCOMH_DESELECT_LEVEL:
+    case SSD1306_CMD_SET_DEEP_SLEEP_MODE:
+        return 1;
+    case SSD1306_CMD_SET_COLUMN_ADDRESS:
+    case SSD1306_CMD_SET_PAGE_ADDRESS:
+    case SSD1306_CMD_SET_SCROLL_VERTICAL_AREA:
+        return 2;
+    case SSD1306_CMD_SET_SCROLL_VERTICAL_RIGHT:
+    case SSD1306_CMD_SET_SCROLL_VERTICAL_LEFT:
+        return 5;
+    case SSD1306_CMD_SET_SCROLL_HORIZONTAL_RIGHT:
+    case SSD1306_CMD_SET_SCROLL_HORIZONTAL_LEFT:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void execute_command(const uint8_t *c)
+{
+    switch (c[0])
+    {
+    case SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE:
+        addressing_mode = c[1] & 0x03;
+        return;
+    case SSD1306_CMD_SET_COLUMN_ADDRESS:
+        col_start = c[1] & 0x7F;
+        col_end = c[2] & 0x7F;
+        col = col_start;
+        return;
+    case SSD1306_CMD_SET_PAGE_ADDRESS:
+        page_start = c[1] & 0x07;
+        page_end = c[2] & 0x07;
+        page = page_start;
+        return;
+    case SSD1306_CMD_SET_CONTRAST:
+        contrast = c[1];
+        return;
+    case SSD1306_CMD_SET_DISPLAY_OFFSET:
+        display_offset = c[1] & 0x3F;
+        return;
+    case SSD1306_CMD_SET_DISPLAY_ON:
+    case SSD1306_CMD_SET_DISPLAY_OFF:
+        display_on = (c[0] == SSD1306_CMD_SET_DISPLAY_ON);
+        return;
+    case SSD1306_CMD_SET_DISPLAY_ALL_ON:
+    case SSD1306_CMD_SET_DISPLAY_ALL_NORMAL:
+        all_on = (c[0] == SSD1306_CMD_SET_DISPLAY_ALL_ON);
+        return;
+    case SSD1306_CMD_SET_INVERSE_DISPLAY:
+    case SSD1306_CMD_SET_NORMAL_DISPLAY:
+        inverse = (c[0] == SSD1306_CMD_SET_INVERSE_DISPLAY);
+        return;
+    default:
+        break;
+    }
+
+    if (c[0] >= SSD1306_CMD_SET_DISPLAY_START_LINE_OFFSET && c[0] <= SSD1306_CMD_SET_DISPLAY_START_LINE_OFFSET + 0x3F)
+    {
+        start_line = c[0] & 0x3F;
+    }
+    else if (c[0] >= SSD1306_CMD_SET_PAGE_START_ADDRESS_OFFSET && c[0] <= SSD1306_CMD_SET_PAGE_START_ADDRESS_OFFSET + 7)
+    {
+        page = c[0] & 0x07; // Page addressing mode
+    }
+    else if (c[0] <= 0x0F)
+    {
+        col = (col & 0xF0) | c[0]; // Lower column nibble (page addressing mode)
+    }
+    else if (c[0] >= SSD1306_CMD_SET_HIGHER_COLUMN_ADDRESS_OFFSET && c[0] <= SSD1306_CMD_SET_HIGHER_COLUMN_ADDRESS_OFFSET + 0x07)
+    {
+        col = (uint8_t)((col & 0x0F) | ((c[0] & 0x07) << 4));
+    }
+}
+
+static void command_byte(uint8_t byte)
+{
+    if (cmd_length == 0)
+    {
+        cmd_expected = command_arguments(byte) + 1;
+    }
+    cmd_bytes[cmd_length++] = byte;
+
+    if (cmd_length == cmd_expected)
+    {
+        execute_command(cmd_bytes);
+        cmd_length = 0;
+    }
+}
+
+// Store one GDDRAM byte and advance the pointers like the controller does in each addressing mode
+static void data_byte(uint8_t byte)
+{
+    gddram[page * SSD1306_WIDTH + col] = byte;
+
+    switch (addressing_mode)
+    {
+    case 0: // Horizontal
+        if (col++ >= col_end)
+        {
+            col = col_start;
+            page = (page >= page_end) ? page_start : page + 1;
+        }
+        break;
+    case 1: // Vertical
+        if (page++ >= page_end)
+        {
+            page = page_start;
+            col = (col >= col_end) ? col_start : col + 1;
+        }
+        break;
+    default: // Page: the column wraps, the page stays
+        col = (col + 1) & 0x7F;
+        break;
+    }
+}
+
+void SSD1306_Delay_Ms_HAL(uint32_t ms)
+{
+    stats.delay_time_us += (uint64_t)ms * 1000;
+}
+
+void SSD1306_IIC_Init_HAL(void)
+{
+    SSD1306_Emu_Reset();
+}
+
+// One I2C write: START + address + control byte + payload + STOP, 9 clocks per byte
+static void transaction(uint8_t mode, const uint8_t *payload, uint16_t length)
+{
+    uint32_t bits = 2 + 9 * (2 + (uint32_t)length);
+
+    stats.transactions++;
+    stats.bus_time_us += (uint64_t)bits * 1000000 / bus_clock_hz;
+
+    if (mode == SSD1306_MODE_DATA)
+    {
+        stats.data_bytes += length;
+        for (uint16_t i = 0; i < length; i++)
+            data_byte(payload[i]);
+    }
+    else
+    {
+        stats.command_bytes += length;
+        for (uint16_t i = 0; i < length; i++)
+            command_byte(payload[i]);
+    }
+}
+
+void SSD1306_Emu_SetAsync(uint8_t enable)
+{
+    SSD1306_Emu_Complete();
+    async_mode = enable;
+}
+
+uint8_t SSD1306_Emu_Complete(void)
+{
+    uint8_t *packet = in_flight;
+
+    if (packet == 0)
+    {
+        return 0;
+    }
+    in_flight = 0;
+    transaction(packet[0], packet + 1, in_flight_length - 1); // The bytes as they are now, like a DMA read
+    return 1;
+}
+
+void SSD1306_IIC_HAL(uint8_t Mode, uint8_t *Command, uint8_t Length)
+{
+    SSD1306_Emu_Complete(); // A blocking write waits for the bus
+    transaction(Mode, Command, Length);
+}
+
+void SSD1306_IIC_Packet_HAL(uint8_t *Packet, uint16_t Length)
+{
+    SSD1306_Emu_Complete();
+    if (Length > 0)
+    {
+        transaction(Packet[0], Packet + 1, Length - 1);
+    }
+}
+
+void SSD1306_IIC_Packet_Start_HAL(uint8_t *Packet, uint16_t Length)
+{
+    SSD1306_Emu_Complete();
+    if (Length == 0)
+    {
+        return;
+    }
+    if (!async_mode)
+    {
+        transaction(Packet[0], Packet + 1, Length - 1);
+        return;
+    }
+    in_flight = Packet;
+    in_flight_length = Length;
+}
+
+uint8_t SSD1306_IIC_Busy_HAL(void)
+{
+    return in_flight != 0;
+}
+
+// Transactions are decoded as they are issued
+void SSD1306_IIC_Flush_HAL(void)
+{
+}
+
+void SSD1306_Emu_Integrate(uint32_t *accumulator, uint32_t weight)
+{
+    uint32_t lit = (uint32_t)(contrast + 1) * weight;
+
+    if (!display_on)
+    {
+        return; // Panel dark
+    }
+
+    for (uint8_t row = 0; row < SSD1306_HEIGHT; row++)
+    {
+        // Row shown on this COM line after the start line and display offset
+        uint8_t ram_row = (row + start_line + display_offset) % SSD1306_HEIGHT;
+        const uint8_t *src = &gddram[(ram_row >> 3) * SSD1306_WIDTH];
+        uint8_t bit = (uint8_t)(1 << (ram_row & 7));
+
+        for (uint8_t x = 0; x < SSD1306_WIDTH; x++)
+        {
+            uint8_t on = all_on || (((src[x] & bit) != 0) != inverse);
+            if (on)
+                accumulator[row * SSD1306_WIDTH + x] += lit;
+        }
+    }
+}
+
+uint8_t SSD1306_Emu_WritePGM(const char *path, const uint32_t *accumulator, uint32_t divisor)
+{
+    static uint32_t current[SSD1306_WIDTH * SSD1306_HEIGHT];
+    FILE *f = fopen(path, "wb");
+
+    if (f == NULL)
+    {
+        return 0;
+    }
+    if (accumulator == NULL)
+    {
+        memset(current, 0, sizeof(current));
+        SSD1306_Emu_Integrate(current, 1);
+        accumulator = current;
+        divisor = 1;
+    }
+    if (divisor == 0)
+    {
+        divisor = 1;
+    }
+
+    fprintf(f, "P5\n%d %d\n255\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    for (uint16_t i = 0; i < SSD1306_WIDTH * SSD1306_HEIGHT; i++)
+    {
+        uint32_t value = accumulator[i] / divisor;
+        fputc(value > 255 ? 255 : (int)value, f);
+    }
+    return fclose(f) == 0;
+}
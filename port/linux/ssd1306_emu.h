@@ -0,0 +1,71 @@
+// Host emulator of the SSD1306 behind the I2C HAL: decodes the command/data stream into a GDDRAM model
+// Link port/linux/ssd1306_emu.c instead of src/ssd1306_HAL.c to run the library on Linux without a panel
+#ifndef __SSD1306_EMU_H
+#define __SSD1306_EMU_H
+
+#include <stdint.h>
+
+// Transfer statistics since the last SSD1306_Emu_Reset()
+typedef struct
+{
+    uint32_t transactions;  // I2C transactions (one per SSD1306_IIC_HAL call)
+    uint32_t command_bytes; // Command payload bytes
+    uint32_t data_bytes;    // GDDRAM payload bytes
+    uint64_t bus_time_us;   // Simulated bus time at the configured clock (address + control + payload, 9 bits per byte)
+    uint64_t delay_time_us; // Time spent in SSD1306_Delay_Ms_HAL()
+} SSD1306_EmuStats;
+
+/**
+ * @brief エミュレータを電源投入直後の状態に戻し、統計をクリアする
+ */
+void SSD1306_Emu_Reset(void);
+
+/**
+ * @brief シミュレーションするI2Cクロックを設定する（既定値は400kHz）
+ * @param hz クロック周波数
+ */
+void SSD1306_Emu_SetBusClock(uint32_t hz);
+
+/**
+ * @brief 転送統計を取得する
+ * @param stats 統計の格納先
+ */
+void SSD1306_Emu_GetStats(SSD1306_EmuStats *stats);
+
+/**
+ * @brief SSD1306_IIC_Packet_Start_HAL()の非同期動作を切り替える
+ * @param enable 1=開始したパケットをSSD1306_Emu_Complete()まで送信中のままにする, 0=即座に完了（既定）
+ * @note 非同期動作ではパケットの内容を完了時に読み出すため、送信中にライブラリがデータを書き換えると検出できる
+ */
+void SSD1306_Emu_SetAsync(uint8_t enable);
+
+/**
+ * @brief 送信中のパケットを完了させる（非同期動作用、DMA完了割り込みの代わり）
+ * @return 1=送信中のパケットがあった, 0=なかった
+ */
+uint8_t SSD1306_Emu_Complete(void);
+
+/**
+ * @brief GDDRAMの内容（ページ形式、1024バイト）を取得する
+ */
+const uint8_t *SSD1306_Emu_GDDRAM(void);
+
+/**
+ * @brief 現在パネルに表示されている明るさでピクセルを積算する
+ * @param accumulator 積算先（128x64要素、行優先）
+ * @param weight 重み（このフレームを表示していた時間など）
+ * @note 表示のON/OFF、反転、全点灯、コントラストを反映する（点灯ピクセル = コントラスト値 + 1）。
+ *       時分割グレースケールの見え方を確認するため、スロットごとに呼び出して平均を取る
+ */
+void SSD1306_Emu_Integrate(uint32_t *accumulator, uint32_t weight);
+
+/**
+ * @brief 積算結果をPGM画像として保存する
+ * @param path 保存先
+ * @param accumulator SSD1306_Emu_Integrate()の積算結果（NULLの場合は現在の表示）
+ * @param divisor 積算値をこの値で割って0-255に収める（スロット数×重みなど、0は1として扱う）
+ * @return 1=成功, 0=書き込み失敗
+ */
+uint8_t SSD1306_Emu_WritePGM(const char *path, const uint32_t *accumulator, uint32_t divisor);
+
+#endif
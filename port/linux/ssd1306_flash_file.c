@@ -0,0 +1,38 @@
+// Linux stand-in for the external SPI flash: reads glyph images from a file
+// Path: $SSD1306_FLASH_IMAGE, or "flash.bin" in the working directory
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306_HAL.h"
+
+static FILE *flash_file = NULL;
+
+void SSD1306_Flash_Init_HAL(void)
+{
+    const char *path = getenv("SSD1306_FLASH_IMAGE");
+
+    if (flash_file != NULL)
+    {
+        fclose(flash_file);
+    }
+    flash_file = fopen(path ? path : "flash.bin", "rb");
+    if (flash_file == NULL)
+    {
+        perror("SSD1306_Flash_Init_HAL");
+    }
+}
+
+void SSD1306_Flash_Read_HAL(uint32_t address, uint8_t *data, uint16_t length)
+{
+    size_t got = 0;
+
+    if (flash_file != NULL && fseek(flash_file, (long)address, SEEK_SET) == 0)
+    {
+        got = fread(data, 1, length, flash_file);
+    }
+
+    // Erased NOR flash reads back as 0xFF
+    memset(data + got, 0xFF, length - got);
+}
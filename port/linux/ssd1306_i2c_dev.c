@@ -0,0 +1,222 @@
+// Linux i2c-dev HAL: batches the transactions of one update into a single I2C_RDWR ioctl
+//
+//   gcc -O2 -Iinclude -Iport/linux -o app app.c src/ssd1306.c port/linux/ssd1306_i2c_dev.c
+//   SSD1306_I2C_DEVICE=/dev/i2c-3 SSD1306_I2C_ADDRESS=0x3D ./app
+//
+// Each batched message is one SSD1306 transaction (address, control byte, payload); I2C_RDWR joins them with
+// repeated STARTs and ends with one STOP, which the controller accepts as a sequence of transactions.
+// Adapters without plain I2C transfers (the kernel's i2c-stub, some SMBus-only controllers) fall back to
+// SMBus I2C block writes of up to 32 bytes, one ioctl each.
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+
+#include "ssd1306.h"
+#include "ssd1306_HAL.h"
+#include "ssd1306_i2c_dev.h"
+
+#define BATCH_BYTES 2048 // A full frame with its window commands
+
+static const char *config_device = NULL;
+static uint8_t config_address = 0;
+static int (*ioctl_fn)(int fd, unsigned long request, void *arg) = NULL;
+
+static int fd = -1;
+static uint16_t address;
+static uint8_t use_smbus = 0;
+
+// Transactions of the current update, copied because the library reuses its buffers as soon as a call returns
+static struct i2c_msg batch[I2C_RDWR_IOCTL_MAX_MSGS];
+static uint8_t batch_data[BATCH_BYTES];
+static uint16_t batch_count = 0;
+static uint16_t batch_bytes = 0;
+
+static SSD1306_I2CDevStats stats;
+
+void SSD1306_I2CDev_Config(const char *device, uint8_t address_7bit)
+{
+    config_device = device;
+    config_address = address_7bit;
+}
+
+void SSD1306_I2CDev_SetIoctl(int (*fn)(int fd, unsigned long request, void *arg))
+{
+    ioctl_fn = fn;
+}
+
+void SSD1306_I2CDev_GetStats(SSD1306_I2CDevStats *out)
+{
+    *out = stats;
+}
+
+static int device_ioctl(unsigned long request, void *arg)
+{
+    return ioctl_fn ? ioctl_fn(fd, request, arg) : ioctl(fd, request, arg);
+}
+
+// Send one message as SMBus I2C block writes: the control byte goes in the command field of each block
+static int smbus_write(const struct i2c_msg *msg)
+{
+    union i2c_smbus_data block;
+    struct i2c_smbus_ioctl_data args;
+    uint16_t offset = 1;
+
+    // Data may be split anywhere (the pointer advances). Commands may be too: the controller keeps its command
+    // parser state across transactions, so the 33-byte SSD1306_InitFast() sequence goes out as 32 + 1 bytes with
+    // the last SSD1306_CMD_SET_PAGE_ADDRESS parameter in the second block
+    do
+    {
+        uint16_t length = msg->len - offset;
+        if (length > I2C_SMBUS_BLOCK_MAX)
+            length = I2C_SMBUS_BLOCK_MAX;
+
+        block.block[0] = (uint8_t)length;
+        memcpy(&block.block[1], &msg->buf[offset], length);
+        args.read_write = I2C_SMBUS_WRITE;
+        args.command = msg->buf[0];
+        args.size = I2C_SMBUS_I2C_BLOCK_DATA;
+        args.data = &block;
+        stats.ioctls++;
+        if (device_ioctl(I2C_SMBUS, &args) < 0)
+            return -1;
+        offset += length;
+    } while (offset < msg->len);
+    return 0;
+}
+
+void SSD1306_IIC_Flush_HAL(void)
+{
+    if (batch_count == 0)
+    {
+        return;
+    }
+
+    if (fd >= 0)
+    {
+        int result = 0;
+
+        if (use_smbus)
+        {
+            for (uint16_t i = 0; i < batch_count && result == 0; i++)
+                result = smbus_write(&batch[i]);
+        }
+        else
+        {
+            struct i2c_rdwr_ioctl_data rdwr = {batch, batch_count};
+
+            stats.ioctls++;
+            result = device_ioctl(I2C_RDWR, &rdwr);
+        }
+        if (result < 0)
+        {
+            stats.errors++;
+        }
+    }
+
+    batch_count = 0;
+    batch_bytes = 0;
+}
+
+// Copy one transaction (control byte + payload) into the batch, submitting the batch first when it is full
+static void append(uint8_t control, const uint8_t *payload, uint16_t length)
+{
+    if (batch_count == I2C_RDWR_IOCTL_MAX_MSGS || batch_bytes + 1 + length > BATCH_BYTES)
+    {
+        SSD1306_IIC_Flush_HAL();
+    }
+
+    uint8_t *buf = &batch_data[batch_bytes];
+    buf[0] = control;
+    memcpy(&buf[1], payload, length);
+
+    batch[batch_count].addr = address;
+    batch[batch_count].flags = 0;
+    batch[batch_count].len = 1 + length;
+    batch[batch_count].buf = buf;
+    batch_count++;
+    batch_bytes += 1 + length;
+
+    stats.transactions++;
+    stats.bytes += 1 + length;
+}
+
+void SSD1306_Delay_Ms_HAL(uint32_t ms)
+{
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000};
+
+    SSD1306_IIC_Flush_HAL(); // Commands before the delay must reach the panel first
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+        ;
+}
+
+void SSD1306_IIC_Init_HAL(void)
+{
+    const char *device = config_device ? config_device : getenv("SSD1306_I2C_DEVICE");
+    const char *env_address = getenv("SSD1306_I2C_ADDRESS");
+    unsigned long funcs = 0;
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    if (device == NULL)
+    {
+        device = "/dev/i2c-1";
+    }
+    address = config_address        ? config_address
+              : env_address != NULL ? (uint16_t)strtoul(env_address, NULL, 0)
+                                    : SSD1306_ADDRESS;
+    batch_count = 0;
+    batch_bytes = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    fd = open(device, O_RDWR);
+    if (fd < 0)
+    {
+        perror(device);
+        return;
+    }
+
+    if (device_ioctl(I2C_FUNCS, &funcs) < 0)
+    {
+        funcs = I2C_FUNC_I2C; // Unknown: try plain transfers
+    }
+    use_smbus = !(funcs & I2C_FUNC_I2C);
+    if (use_smbus && !(funcs & I2C_FUNC_SMBUS_WRITE_I2C_BLOCK))
+    {
+        fprintf(stderr, "%s: adapter supports neither I2C transfers nor SMBus block writes\n", device);
+    }
+    if (device_ioctl(I2C_SLAVE, (void *)(unsigned long)address) < 0)
+    {
+        perror("I2C_SLAVE"); // Only the SMBus fallback needs it
+    }
+}
+
+void SSD1306_IIC_HAL(uint8_t Mode, uint8_t *Command, uint8_t Length)
+{
+    append(Mode, Command, Length);
+}
+
+void SSD1306_IIC_Packet_HAL(uint8_t *Packet, uint16_t Length)
+{
+    append(Packet[0], &Packet[1], Length - 1);
+}
+
+// Copied into the batch, so the packet is complete on return and the transfer is never busy
+void SSD1306_IIC_Packet_Start_HAL(uint8_t *Packet, uint16_t Length)
+{
+    SSD1306_IIC_Packet_HAL(Packet, Length);
+}
+
+uint8_t SSD1306_IIC_Busy_HAL(void)
+{
+    return 0;
+}
@@ -0,0 +1,40 @@
+// Linux i2c-dev HAL: drives a real panel through /dev/i2c-N from a single-board computer
+// Link port/linux/ssd1306_i2c_dev.c instead of src/ssd1306_HAL.c; the transactions of one update are batched
+// and submitted as one I2C_RDWR ioctl when the library calls SSD1306_IIC_Flush_HAL()
+#ifndef __SSD1306_I2C_DEV_H
+#define __SSD1306_I2C_DEV_H
+
+#include <stdint.h>
+
+// Transfer statistics since the device was opened
+typedef struct
+{
+    uint32_t ioctls;       // Syscalls issued (one I2C_RDWR per update, or one per SMBus block)
+    uint32_t transactions; // I2C transactions (START ... STOP or repeated START)
+    uint32_t bytes;        // Bytes sent after the address (control bytes included)
+    uint32_t errors;       // Failed ioctls (the update is lost, the next one is tried as usual)
+} SSD1306_I2CDevStats;
+
+/**
+ * @brief 使用するI2Cデバイスとスレーブアドレスを設定する（SSD1306_Init()の前に呼び出す）
+ * @param device デバイスファイル（NULLで環境変数SSD1306_I2C_DEVICE、未設定なら"/dev/i2c-1"）
+ * @param address 7ビットアドレス（0で環境変数SSD1306_I2C_ADDRESS、未設定ならSSD1306_ADDRESS）
+ * @note SSD1306_Init()（SSD1306_IIC_Init_HAL()）がデバイスを開き直すので、実行時にバスを切り替えられる
+ */
+void SSD1306_I2CDev_Config(const char *device, uint8_t address);
+
+/**
+ * @brief ioctl()の呼び出しを差し替える（ハードウェアなしでのテスト用）
+ * @param fn ioctl()と同じ引数の関数（NULLで本物のioctl()に戻す）
+ * @note I2C_FUNCS・I2C_SLAVE・I2C_RDWR・I2C_SMBUSがこの関数を通る。
+ *       デバイスファイルは開けるものであれば何でもよい（"/dev/null"等）
+ */
+void SSD1306_I2CDev_SetIoctl(int (*fn)(int fd, unsigned long request, void *arg));
+
+/**
+ * @brief 転送統計を取得する
+ * @param stats 統計の格納先
+ */
+void SSD1306_I2CDev_GetStats(SSD1306_I2CDevStats *stats);
+
+#endif
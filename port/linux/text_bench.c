@@ -0,0 +1,140 @@
+// Host benchmark of the printf-free number renderers: times sprintf+SSD1306_DrawString() against
+// SSD1306_DrawInt() / SSD1306_DrawFixed() / SSD1306_DrawTime(), checks that both draw the same pixels,
+// and reports the size of the program text so the two paths can be linked on their own and compared
+//
+//   gcc -O2 -Iinclude -Iport/linux -o text_bench port/linux/text_bench.c port/linux/ssd1306_emu.c src/ssd1306.c
+//   ./text_bench [calls]
+//
+//   # Program text of each path alone
+//   gcc -Os -ffunction-sections -Wl,--gc-sections -DTEXT_BENCH_ONLY=1 ... -o text_sprintf
+//   gcc -Os -ffunction-sections -Wl,--gc-sections -DTEXT_BENCH_ONLY=2 ... -o text_integer
+//   ./text_sprintf 1; ./text_integer 1
+//
+// The single-path builds link libc dynamically: the difference is the renderers against the sprintf call sites,
+// and the sprintf build needs the libc formatter on top (a static glibc links it either way, so it cannot be
+// isolated there; on the target it is newlib's _vfprintf_r)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+// 0 = both paths, 1 = sprintf+DrawString only, 2 = integer renderers only
+#ifndef TEXT_BENCH_ONLY
+#define TEXT_BENCH_ONLY 0
+#endif
+
+// Program text bounds from the linker
+extern char __executable_start;
+extern char etext;
+
+// Print the text size without stdio, so the single-path builds link no formatting code of their own
+static void report_text_size(void)
+{
+    char line[48] = "program text: ";
+    char digits[12];
+    long size = (long)(&etext - &__executable_start);
+    uint8_t count = 0;
+    size_t length = strlen(line);
+
+    do
+    {
+        digits[count++] = (char)('0' + size % 10);
+        size /= 10;
+    } while (size);
+    while (count)
+        line[length++] = digits[--count];
+    memcpy(&line[length], " bytes\n", 7);
+    if (write(STDOUT_FILENO, line, length + 7) < 0)
+        exit(1);
+}
+
+#if TEXT_BENCH_ONLY == 0
+static double now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+#endif
+
+// Draw an integer, a fixed-point value and a time of day in the first three text rows
+#if TEXT_BENCH_ONLY != 2
+static void draw_sprintf(uint32_t i)
+{
+    char str[16];
+    int32_t fixed = (int32_t)(i * 37) - 5000;
+    int32_t magnitude = fixed < 0 ? -fixed : fixed;
+
+    SSD1306_FillRect(0, 0, 128, 24, 0);
+    sprintf(str, "%ld", (long)(i * 37));
+    SSD1306_DrawString(0, 0, str, 1);
+    sprintf(str, "%s%ld.%02ld", fixed < 0 ? "-" : "", (long)(magnitude / 100), (long)(magnitude % 100));
+    SSD1306_DrawString(0, 8, str, 1);
+    sprintf(str, "%02u:%02u:%02u", (unsigned)(i % 24), (unsigned)(i % 60), (unsigned)((i * 7) % 60));
+    SSD1306_DrawString(0, 16, str, 1);
+}
+#endif
+
+#if TEXT_BENCH_ONLY != 1
+static void draw_integer(uint32_t i)
+{
+    SSD1306_FillRect(0, 0, 128, 24, 0);
+    SSD1306_DrawInt(0, 0, (int32_t)(i * 37), 0, 1);
+    SSD1306_DrawFixed(0, 8, (int32_t)(i * 37) - 5000, 2, 1);
+    SSD1306_DrawTime(0, 16, i % 24, i % 60, (i * 7) % 60, 1);
+}
+#endif
+
+int main(int argc, char **argv)
+{
+    uint32_t calls = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 100000;
+
+    SSD1306_Init();
+
+#if TEXT_BENCH_ONLY == 0
+    uint32_t mismatches = 0;
+    double sprintf_us = 0;
+    double integer_us = 0;
+
+    for (uint32_t i = 0; i < calls; i++)
+    {
+        uint8_t expected[128 * 3];
+        uint8_t drawn[128 * 3];
+        double t0 = now_us();
+
+        draw_sprintf(i);
+        sprintf_us += now_us() - t0;
+        SSD1306_ReadBitmap(0, 0, expected, 128, 24);
+
+        t0 = now_us();
+        draw_integer(i);
+        integer_us += now_us() - t0;
+        SSD1306_ReadBitmap(0, 0, drawn, 128, 24);
+        if (memcmp(expected, drawn, sizeof(drawn)) != 0)
+            mismatches++;
+    }
+
+    printf("sprintf+DrawString: %.3f us per integer+fixed+time\n", sprintf_us / calls);
+    printf("DrawInt/DrawFixed/DrawTime: %.3f us per integer+fixed+time\n", integer_us / calls);
+    printf("%u of %u calls drew different pixels\n", mismatches, calls);
+    fflush(stdout);
+    report_text_size();
+    return mismatches != 0;
+#else
+    for (uint32_t i = 0; i < calls; i++)
+    {
+#if TEXT_BENCH_ONLY == 1
+        draw_sprintf(i);
+#else
+        draw_integer(i);
+#endif
+    }
+    report_text_size();
+    return 0;
+#endif
+}
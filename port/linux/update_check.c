@@ -0,0 +1,312 @@
+// Host check of the update paths: random draws, Invalidate calls, streams and display settings interleaved with
+// SSD1306_Update / UpdateDirty / UpdateStep / Update_Full / Update_Swap / UpdateFrom and an asynchronous
+// Present/Poll, comparing the emulator's GDDRAM with the frame each step must leave on the panel
+//
+//   gcc -O2 -Iinclude -Iport/linux -o update_check port/linux/update_check.c port/linux/ssd1306_emu.c src/ssd1306.c
+//   ./update_check [steps] [seed]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+
+#define PAGES (SSD1306_HEIGHT / 8)
+
+static const char *const op_names[] = {"Update",     "UpdateDirty", "UpdateStep", "Update_Full", "Update_Swap",
+                                       "UpdateFrom", "Present",     "Stream",     "Stream (in Present)"};
+
+enum
+{
+    OP_UPDATE,
+    OP_UPDATE_DIRTY,
+    OP_UPDATE_STEP,
+    OP_UPDATE_FULL,
+    OP_UPDATE_SWAP,
+    OP_UPDATE_FROM,
+    OP_PRESENT,
+    OP_STREAM,
+    OP_STREAM_IN_PRESENT,
+    OP_COUNT
+};
+
+static uint8_t shown[SSD1306_BUFFER_SIZE]; // Panel contents after the last check
+static uint32_t checks[OP_COUNT];
+static uint32_t failures;
+
+// Columns where the panel may differ from the draw buffer without the library knowing (streams without
+// SSD1306_STREAM_BUFFER, UpdateFrom, a partial UpdateStep): the application registers them before UpdateDirty
+static uint8_t owed_start[PAGES];
+static uint8_t owed_end[PAGES]; // End exclusive, start == end = nothing owed
+
+static void owe(uint8_t page, uint8_t start_col, uint8_t end_col)
+{
+    if (owed_start[page] == owed_end[page])
+    {
+        owed_start[page] = start_col;
+        owed_end[page] = end_col;
+        return;
+    }
+    if (start_col < owed_start[page])
+        owed_start[page] = start_col;
+    if (end_col > owed_end[page])
+        owed_end[page] = end_col;
+}
+
+static void owe_all(void)
+{
+    for (uint8_t page = 0; page < PAGES; page++)
+        owe(page, 0, SSD1306_WIDTH);
+}
+
+static void clear_owed(void)
+{
+    memset(owed_start, 0, sizeof(owed_start));
+    memset(owed_end, 0, sizeof(owed_end));
+}
+
+// Owe the columns where the panel still differs from the frame
+static void owe_differences(const uint8_t *frame)
+{
+    const uint8_t *gddram = SSD1306_Emu_GDDRAM();
+
+    for (uint16_t i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    {
+        if (gddram[i] != frame[i])
+            owe((uint8_t)(i / SSD1306_WIDTH), (uint8_t)(i % SSD1306_WIDTH), (uint8_t)(i % SSD1306_WIDTH + 1));
+    }
+}
+
+static void read_buffer(uint8_t *frame)
+{
+    SSD1306_ReadBitmap(0, 0, frame, SSD1306_WIDTH, SSD1306_HEIGHT);
+}
+
+static void report(uint8_t op, uint32_t step, const char *what, uint16_t index, uint8_t expected)
+{
+    if (failures++ < 8)
+        printf("step %u %s: %s at page %u column %u (panel %02X, expected %02X)\n", step, op_names[op], what,
+               index / SSD1306_WIDTH, index % SSD1306_WIDTH, SSD1306_Emu_GDDRAM()[index], expected);
+}
+
+// The panel must show exactly the frame
+static void expect_frame(uint8_t op, uint32_t step, const uint8_t *frame)
+{
+    const uint8_t *gddram = SSD1306_Emu_GDDRAM();
+
+    checks[op]++;
+    for (uint16_t i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    {
+        if (gddram[i] != frame[i])
+        {
+            report(op, step, "differs", i, frame[i]);
+            break;
+        }
+    }
+    memcpy(shown, gddram, SSD1306_BUFFER_SIZE);
+}
+
+// Part way through a transfer: every byte is either what the panel showed before or the new frame
+static void expect_progress(uint8_t op, uint32_t step, const uint8_t *frame)
+{
+    const uint8_t *gddram = SSD1306_Emu_GDDRAM();
+
+    checks[op]++;
+    for (uint16_t i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    {
+        if (gddram[i] != shown[i] && gddram[i] != frame[i])
+        {
+            report(op, step, "neither old nor new", i, frame[i]);
+            break;
+        }
+    }
+    memcpy(shown, gddram, SSD1306_BUFFER_SIZE);
+}
+
+static int16_t random_range(int16_t lo, int16_t hi)
+{
+    return (int16_t)(lo + rand() % (hi - lo + 1));
+}
+
+// Draw a random rectangle and register it; narrow, tall ones go out as vertical addressing boxes
+static void random_draw(void)
+{
+    static const uint8_t colors[] = {0, 1, SSD1306_COLOR_INVERT};
+    int16_t x = random_range(-4, SSD1306_WIDTH + 3);
+    int16_t y = random_range(-4, SSD1306_HEIGHT + 3);
+    uint8_t width, height;
+
+    switch (rand() % 4)
+    {
+    case 0:
+        width = (uint8_t)random_range(1, 6);
+        height = (uint8_t)random_range(9, SSD1306_HEIGHT);
+        break;
+    case 1:
+        width = (uint8_t)random_range(1, SSD1306_WIDTH);
+        height = (uint8_t)random_range(1, 8);
+        break;
+    default:
+        width = (uint8_t)random_range(1, 16);
+        height = (uint8_t)random_range(1, 16);
+        break;
+    }
+
+    SSD1306_FillRect(x, y, width, height, colors[rand() % 3]);
+    SSD1306_Invalidate(x, y, width, height);
+}
+
+// Stream random bytes straight to the panel and account for where they end up
+static void random_stream(uint8_t flags)
+{
+    static uint8_t bitmap[SSD1306_BUFFER_SIZE];
+    uint8_t x = (uint8_t)random_range(0, SSD1306_WIDTH + 8);
+    uint8_t page = (uint8_t)random_range(0, PAGES);
+    uint8_t width = (uint8_t)random_range(1, SSD1306_WIDTH + 4);
+    uint8_t pages = (uint8_t)random_range(1, PAGES + 1);
+
+    if (width * pages > SSD1306_BUFFER_SIZE)
+        pages = (uint8_t)(SSD1306_BUFFER_SIZE / width);
+    for (uint16_t i = 0; i < width * pages; i++)
+        bitmap[i] = (uint8_t)rand();
+
+    SSD1306_StreamBitmap(x, page, bitmap, width, pages, flags);
+
+    for (uint8_t p = 0; p < pages && page + p < PAGES; p++)
+    {
+        for (uint8_t c = 0; c < width && x + c < SSD1306_WIDTH; c++)
+            shown[(page + p) * SSD1306_WIDTH + x + c] = bitmap[p * width + c];
+        if (!(flags & SSD1306_STREAM_BUFFER) && x < SSD1306_WIDTH)
+            owe(page + p, x, (x + width < SSD1306_WIDTH) ? x + width : SSD1306_WIDTH);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t steps = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 20000;
+    uint8_t frame[SSD1306_BUFFER_SIZE];
+
+    srand((argc > 2) ? (unsigned)strtoul(argv[2], NULL, 0) : 1);
+    SSD1306_Init();
+    memcpy(shown, SSD1306_Emu_GDDRAM(), SSD1306_BUFFER_SIZE);
+
+    for (uint32_t step = 0; step < steps; step++)
+    {
+        for (uint8_t n = (uint8_t)(rand() % 5); n; n--)
+            random_draw();
+        if (rand() % 4 == 0)
+            SSD1306_Invalidate(random_range(-8, SSD1306_WIDTH), random_range(-8, SSD1306_HEIGHT),
+                               (uint8_t)random_range(1, 40), (uint8_t)random_range(1, 40));
+        if (rand() % 8 == 0)
+            SSD1306_InvalidatePriority(random_range(0, SSD1306_WIDTH - 1), random_range(0, SSD1306_HEIGHT - 1),
+                                       (uint8_t)random_range(1, 40), (uint8_t)random_range(1, 40));
+        if (rand() % 6 == 0)
+            SSD1306_SetContrast((uint8_t)rand());
+
+        uint8_t op = (uint8_t)(rand() % OP_COUNT);
+        read_buffer(frame);
+
+        switch (op)
+        {
+        case OP_UPDATE:
+            SSD1306_Update();
+            expect_frame(op, step, frame);
+            clear_owed();
+            break;
+
+        case OP_UPDATE_DIRTY:
+            for (uint8_t page = 0; page < PAGES; page++)
+            {
+                if (owed_start[page] != owed_end[page])
+                    SSD1306_Invalidate(owed_start[page], page * 8, owed_end[page] - owed_start[page], 8);
+            }
+            SSD1306_UpdateDirty();
+            expect_frame(op, step, frame);
+            clear_owed();
+            break;
+
+        case OP_UPDATE_STEP:
+            if (SSD1306_UpdateStep((uint16_t)random_range(0, 600)))
+            {
+                expect_frame(op, step, frame);
+                clear_owed();
+            }
+            else
+            {
+                expect_progress(op, step, frame);
+                owe_differences(frame); // Sent later by UpdateStep, but not by UpdateDirty
+            }
+            break;
+
+        case OP_UPDATE_FULL:
+            SSD1306_Update_Full();
+            expect_frame(op, step, frame);
+            clear_owed();
+            break;
+
+        case OP_UPDATE_SWAP:
+            SSD1306_Update_Swap();
+            expect_frame(op, step, frame);
+            clear_owed();
+            // The draw buffer now holds an older frame: redraw the whole screen, as callers of Update_Swap do
+            SSD1306_DrawBitmapEx(0, 0, frame, SSD1306_WIDTH, SSD1306_HEIGHT, SSD1306_BITMAP_PAGE_MAJOR,
+                                 SSD1306_BLIT_OPAQUE);
+            break;
+
+        case OP_UPDATE_FROM:
+        {
+            uint8_t other[SSD1306_BUFFER_SIZE];
+            for (uint16_t i = 0; i < SSD1306_BUFFER_SIZE; i++)
+                other[i] = (rand() % 4) ? shown[i] : (uint8_t)rand();
+            SSD1306_UpdateFrom(other);
+            expect_frame(op, step, other);
+            owe_all();
+            break;
+        }
+
+        case OP_PRESENT:
+        case OP_STREAM_IN_PRESENT:
+            SSD1306_Emu_SetAsync(1);
+            SSD1306_Present();
+            for (uint8_t k = (uint8_t)(rand() % 12); k && SSD1306_Emu_Complete(); k--)
+            {
+                SSD1306_Poll();
+                expect_progress(op, step, frame);
+            }
+            if (op == OP_PRESENT)
+            {
+                while (SSD1306_Emu_Complete())
+                    SSD1306_Poll();
+                SSD1306_Acquire(1);
+                SSD1306_Emu_SetAsync(0);
+                expect_frame(op, step, frame);
+                clear_owed();
+                break;
+            }
+            // A stream while the frame is still going out finishes the frame first
+            SSD1306_Emu_SetAsync(0);
+            SSD1306_Emu_Complete();
+            memcpy(shown, frame, SSD1306_BUFFER_SIZE);
+            clear_owed();
+            random_stream((uint8_t)(rand() % 2) * SSD1306_STREAM_SHADOW);
+            SSD1306_Acquire(1);
+            expect_frame(op, step, shown);
+            break;
+
+        default:
+            random_stream((uint8_t)(rand() % 4));
+            expect_frame(op, step, shown);
+            break;
+        }
+    }
+
+    uint32_t total = 0;
+    for (uint8_t op = 0; op < OP_COUNT; op++)
+    {
+        printf("%-20s %u checks\n", op_names[op], checks[op]);
+        total += checks[op];
+    }
+    printf("%u of %u checks failed\n", failures, total);
+    return failures != 0;
+}
@@ -26,14 +26,19 @@
 #include "debug.h"
 #include "ssd1306.h"
 #include "ssd1306_HAL.h"
-
-#include <math.h>
-
-asm(".global _printf_float");
+#include "ssd1306_sprite.h"
+#include "ssd1306_anim.h"
+#include "image_sample.h"
+#include "image_sample_raw.h"
+#include "anim_spinner.h"
 
 void FunctionTest();
 void smooth_animation();
 void ClockTest();
+void NumberTest();
+void ImageTest();
+void AnimTest();
+void PrintElapsed(const char *name);
 
 void GPIO_Toggle_INIT(void)
 {
@@ -99,7 +104,11 @@ int main(void)
     GPIO_Toggle_INIT();
     TIM1_Init(65535 - 1, 4800 - 1, 50);
 
-    SSD1306_Init();
+    // Boot straight into the splash image (port/linux/init_bench.c compares this with SSD1306_Init())
+    TIM1->CNT = 0;
+    SSD1306_InitFast(&image_sample);
+    PrintElapsed("SSD1306_InitFast");
+    Delay_Ms(1000);
 
     while (1)
     {
@@ -109,15 +118,33 @@ int main(void)
         TIM1->CNT = 0;
         smooth_animation();
         int cnt = TIM1->CNT;
-        printf("smooth_animation:%.1fms, %.2fHz\r\n", cnt / 10.0f, 200.0f / cnt * 10000.0f);
+        int hz100 = 200000000 / cnt; // 200 frames / (cnt * 0.1ms) in 1/100 Hz
+        printf("smooth_animation:%d.%dms, %d.%02dHz\r\n", cnt / 10, cnt % 10, hz100 / 100, hz100 % 100);
         Delay_Ms(500);
 
         TIM1->CNT = 0;
         ClockTest();
-        printf("ClockTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+        PrintElapsed("ClockTest");
+        Delay_Ms(500);
+
+        NumberTest();
+        Delay_Ms(500);
+
+        ImageTest();
+        Delay_Ms(1000);
+
+        AnimTest();
+        Delay_Ms(500);
     }
 }
 
+// Print TIM1 ticks (0.1ms) since the last reset without printf float support
+void PrintElapsed(const char *name)
+{
+    int cnt = TIM1->CNT;
+    printf("%s:%d.%dms\r\n", name, cnt / 10, cnt % 10);
+}
+
 void PixelTest()
 {
     SSD1306_Clear();
@@ -221,7 +248,7 @@ void CircleTest()
 {
     SSD1306_Clear();
     int16_t i;
-    for (i = 0; i < fmax(SSD1306_WIDTH, SSD1306_HEIGHT) / 2; i += 2)
+    for (i = 0; i < (SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT) / 2; i += 2)
     {
         SSD1306_DrawCircle(SSD1306_WIDTH / 2, SSD1306_HEIGHT / 2, i, 1);
         SSD1306_Update();
@@ -229,7 +256,7 @@ void CircleTest()
     // Delay_Ms(500);
 
     SSD1306_Clear();
-    i = fmax(SSD1306_WIDTH, SSD1306_HEIGHT) / 2;
+    i = (SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT) / 2;
     for (; i > 0; i -= 3)
     {
         // The INVERSE color is used so circles alternate white/black
@@ -282,7 +309,7 @@ void TriangleTest()
     int i;
     SSD1306_Clear();
 
-    for (i = 0; i < fmax(SSD1306_WIDTH, SSD1306_HEIGHT) / 2; i += 5)
+    for (i = 0; i < (SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT) / 2; i += 5)
     {
         SSD1306_DrawTriangle(
             SSD1306_WIDTH / 2, SSD1306_HEIGHT / 2 - i,
@@ -294,7 +321,7 @@ void TriangleTest()
 
     SSD1306_Clear();
 
-    i = fmax(SSD1306_WIDTH, SSD1306_HEIGHT) / 2;
+    i = (SSD1306_WIDTH > SSD1306_HEIGHT ? SSD1306_WIDTH : SSD1306_HEIGHT) / 2;
     for (; i > 0; i -= 5)
     {
         // The INVERSE color is used so triangles alternate white/black
@@ -349,77 +376,117 @@ void FunctionTest(void)
 {
     TIM1->CNT = 0;
     Delay_Ms(1);
-    printf("Delay:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("Delay");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     Delay_Ms(1);
-    printf("Delay:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("Delay");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     PixelTest();
-    printf("PixelTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("PixelTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     LineTest();
-    printf("LineTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("LineTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     RectTest();
-    printf("RectTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("RectTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     CircleTest();
-    printf("CircleTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("CircleTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     EllipseTest();
-    printf("EllipseTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("EllipseTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     RoundRectTest();
-    printf("RoundRectTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("RoundRectTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     TriangleTest();
-    printf("TriangleTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("TriangleTest");
     Delay_Ms(500);
 
     TIM1->CNT = 0;
     StringTest();
-    printf("StringTest:%.1fms\r\n", TIM1->CNT / 10.0f);
+    PrintElapsed("StringTest");
 }
 
 void smooth_animation(void)
 {
+    static uint8_t ball[SSD1306_SPRITE_SAVE_SIZE(17, 17)];
+    static uint8_t ball_save[SSD1306_SPRITE_SAVE_SIZE(17, 17)];
+    SSD1306_Sprite sprite;
     int frame = 0;
-    uint8_t str[8];
-    while (frame++ < 600)
-    { // Clear drawing buffer
 
-        SSD1306_Clear();
+    // Render the ball once and capture it as the sprite image
+    SSD1306_Clear();
+    SSD1306_FillCircle(8, 8, 8, 1);
+    SSD1306_ReadBitmap(0, 0, ball, 17, 17);
 
-        // Draw multiple animated objects
-        int x = 64 + 30 * sinf(frame * 0.05f);
-        int y = 32 + 20 * cosf(frame * 0.05f);
+    // Static background is drawn once; the sprite restores it as the ball moves
+    SSD1306_Clear();
+    SSD1306_DrawRect(20, 20, 80, 30, 1);
+    SSD1306_DrawString(0, 0, "Frame:", 1);
+    SSD1306_Update();
 
-        SSD1306_FillCircle(x, y, 8, 1);
-        SSD1306_DrawRect(20, 20, 80, 30, 1);
-        sprintf((char *)str, "Frame: %d", frame);
-        SSD1306_DrawString(0, 0, (const char *)str, 1);
+    SSD1306_Sprite_Init(&sprite, ball, NULL, ball_save, 17, 17, SSD1306_SPRITE_SAVE_UNDER);
+    SSD1306_Sprite_Register(&sprite);
+    SSD1306_Sprite_Show(&sprite, 1);
+
+    while (frame++ < 600)
+    {
+        int16_t angle = frame * 2865 / 100; // 0.05 rad per frame in 0.1 degree units
+        int x = 64 + ((30 * SSD1306_Sin(angle)) >> 15);
+        int y = 32 + ((20 * SSD1306_Cos(angle)) >> 15);
+
+        // Lift the ball before redrawing the counter it may overlap
+        SSD1306_Sprite_Begin();
+        SSD1306_FillRect(56, 0, 72, 8, 0);
+        SSD1306_DrawInt(56, 0, frame, 0, 1);
+        SSD1306_Invalidate(56, 0, 72, 8);
+
+        SSD1306_Sprite_MoveTo(&sprite, x - 8, y - 8);
+        SSD1306_Sprite_End();
         GPIO_WriteBit(GPIOA, GPIO_Pin_0, Bit_SET);
 
-        // Single optimized update
-        SSD1306_Update(); // Only changed regions transmitted
+        // Only the counter and the ball's old/new boxes are compared and transmitted
+        SSD1306_UpdateDirty();
         GPIO_WriteBit(GPIOA, GPIO_Pin_0, Bit_RESET);
     }
+
+    SSD1306_Sprite_Unregister(&sprite);
+}
+
+// Analog clock face in integer angle units (no floating point)
+static void DrawAnalogClock(uint8_t cx, uint8_t cy, uint8_t radius, uint8_t hours, uint8_t minutes, uint8_t seconds)
+{
+    // Clock face border
+    SSD1306_DrawCircle(cx, cy, radius, 1);
+
+    // Hour markers (12, 3, 6, 9) and minute markers (small dots) in between
+    SSD1306_DrawTickRing(cx, cy, radius - 3, radius - 1, 4, 0, 1);
+    SSD1306_DrawTickRing(cx, cy, radius - 2, radius - 2, 12, 3, 1);
+
+    // Hands: hour (thick, short), minute (medium length), second (thin, long)
+    SSD1306_DrawNeedle(cx, cy, radius - 12, 3, (hours % 12) * 300 + minutes * 5, 1);
+    SSD1306_DrawNeedle(cx, cy, radius - 6, 1, minutes * 60, 1);
+    SSD1306_DrawNeedle(cx, cy, radius - 3, 1, seconds * 60, 1);
+
+    // Center dot
+    SSD1306_FillCircle(cx, cy, 2, 1);
 }
 
 void ClockTest()
@@ -474,55 +541,7 @@ void ClockTest()
     SSD1306_DrawString(0, 56, "24.5℃", 1);
 
     // === ANALOG CLOCK (Right Side) ===
-    // Draw clock face border
-    SSD1306_DrawCircle(analog_center_x, analog_center_y, analog_radius, 1);
-
-    // Draw hour markers (12, 3, 6, 9)
-    for (int i = 0; i < 4; i++)
-    {
-        float angle = i * 90.0 * 3.14159 / 180.0; // Convert to radians
-        int x1 = analog_center_x + (analog_radius - 3) * cos(angle);
-        int y1 = analog_center_y + (analog_radius - 3) * sin(angle);
-        int x2 = analog_center_x + (analog_radius - 1) * cos(angle);
-        int y2 = analog_center_y + (analog_radius - 1) * sin(angle);
-        SSD1306_DrawLine(x1, y1, x2, y2, 1);
-    }
-
-    // Draw minute markers (small dots)
-    for (int i = 0; i < 12; i++)
-    {
-        if (i % 3 != 0)
-        {                                                           // Skip hour markers
-            float angle = i * 30.0 * 3.14159 / 180.0 - 3.14159 / 2; // -90° offset
-            int x = analog_center_x + (analog_radius - 2) * cos(angle);
-            int y = analog_center_y + (analog_radius - 2) * sin(angle);
-            SSD1306_DrawPixel(x, y, 1);
-        }
-    }
-
-    // Calculate hand angles (12 o'clock = -90 degrees)
-    float hour_angle = ((hours % 12) * 30.0 + minutes * 0.5) * 3.14159 / 180.0 - 3.14159 / 2;
-    float minute_angle = (minutes * 6.0) * 3.14159 / 180.0 - 3.14159 / 2;
-    float second_angle = (seconds * 6.0) * 3.14159 / 180.0 - 3.14159 / 2;
-
-    // Draw hour hand (thick, short)
-    int hour_x = analog_center_x + (analog_radius - 12) * cos(hour_angle);
-    int hour_y = analog_center_y + (analog_radius - 12) * sin(hour_angle);
-    SSD1306_DrawLine(analog_center_x, analog_center_y, hour_x, hour_y, 1);
-    SSD1306_DrawLine(analog_center_x - 1, analog_center_y, hour_x - 1, hour_y, 1); // Make thick
-
-    // Draw minute hand (medium length)
-    int minute_x = analog_center_x + (analog_radius - 6) * cos(minute_angle);
-    int minute_y = analog_center_y + (analog_radius - 6) * sin(minute_angle);
-    SSD1306_DrawLine(analog_center_x, analog_center_y, minute_x, minute_y, 1);
-
-    // Draw second hand (thin, long)
-    int second_x = analog_center_x + (analog_radius - 3) * cos(second_angle);
-    int second_y = analog_center_y + (analog_radius - 3) * sin(second_angle);
-    SSD1306_DrawLine(analog_center_x, analog_center_y, second_x, second_y, 1);
-
-    // Draw center dot
-    SSD1306_FillCircle(analog_center_x, analog_center_y, 2, 1);
+    DrawAnalogClock(analog_center_x, analog_center_y, analog_radius, hours, minutes, seconds);
 
     // Draw separator line between digital and analog
     SSD1306_DrawLine(64, 0, 64, 63, 1);
@@ -536,10 +555,8 @@ void ClockTest()
         // Delay_Ms(200);
 
         // Display time in HH:MM:SS format
-        char time_str[16];
-        sprintf(time_str, "%02d:%02d:%02d", hours, minutes, seconds);
         SSD1306_FillRect(0, 16, 63, 23, 0); // Clear previous time
-        SSD1306_DrawString(0, 16, time_str, 1);
+        SSD1306_DrawTime(0, 16, hours, minutes, seconds, 1);
 
         // Update seconds for animation
         seconds++;
@@ -562,51 +579,8 @@ void ClockTest()
         // Clear previous hands area
         SSD1306_FillCircle(analog_center_x, analog_center_y, analog_radius - 2, 0);
 
-        // Redraw clock face
-        SSD1306_DrawCircle(analog_center_x, analog_center_y, analog_radius, 1);
-
-        // Redraw markers
-        for (int j = 0; j < 4; j++)
-        {
-            float angle = j * 90.0 * 3.14159 / 180.0;
-            int x1 = analog_center_x + (analog_radius - 3) * cos(angle);
-            int y1 = analog_center_y + (analog_radius - 3) * sin(angle);
-            int x2 = analog_center_x + (analog_radius - 1) * cos(angle);
-            int y2 = analog_center_y + (analog_radius - 1) * sin(angle);
-            SSD1306_DrawLine(x1, y1, x2, y2, 1);
-        }
-
-        // Redraw minute markers
-        for (int j = 0; j < 12; j++)
-        {
-            if (j % 3 != 0)
-            {
-                float angle = j * 30.0 * 3.14159 / 180.0 - 3.14159 / 2;
-                int x = analog_center_x + (analog_radius - 2) * cos(angle);
-                int y = analog_center_y + (analog_radius - 2) * sin(angle);
-                SSD1306_DrawPixel(x, y, 1);
-            }
-        }
-
-        // Recalculate and redraw hands
-        hour_angle = ((hours % 12) * 30.0 + minutes * 0.5) * 3.14159 / 180.0 - 3.14159 / 2;
-        minute_angle = (minutes * 6.0) * 3.14159 / 180.0 - 3.14159 / 2;
-        second_angle = (seconds * 6.0) * 3.14159 / 180.0 - 3.14159 / 2;
-
-        hour_x = analog_center_x + (analog_radius - 12) * cos(hour_angle);
-        hour_y = analog_center_y + (analog_radius - 12) * sin(hour_angle);
-        SSD1306_DrawLine(analog_center_x, analog_center_y, hour_x, hour_y, 1);
-        SSD1306_DrawLine(analog_center_x - 1, analog_center_y, hour_x - 1, hour_y, 1);
-
-        minute_x = analog_center_x + (analog_radius - 6) * cos(minute_angle);
-        minute_y = analog_center_y + (analog_radius - 6) * sin(minute_angle);
-        SSD1306_DrawLine(analog_center_x, analog_center_y, minute_x, minute_y, 1);
-
-        second_x = analog_center_x + (analog_radius - 3) * cos(second_angle);
-        second_y = analog_center_y + (analog_radius - 3) * sin(second_angle);
-        SSD1306_DrawLine(analog_center_x, analog_center_y, second_x, second_y, 1);
-
-        SSD1306_FillCircle(analog_center_x, analog_center_y, 2, 1);
+        // Redraw clock face and hands
+        DrawAnalogClock(analog_center_x, analog_center_y, analog_radius, hours, minutes, seconds);
 
         // Draw clock numbers (12, 3, 6, 9)
         SSD1306_DrawString(analog_center_x - 8, analog_center_y - analog_radius + 5, "12", 1);
@@ -617,4 +591,96 @@ void ClockTest()
         SSD1306_Update();
         GPIO_WriteBit(GPIOA, GPIO_Pin_0, Bit_RESET);
     }
-}
\ No newline at end of file
+}
+
+// Compare sprintf + DrawString against the printf-free number renderers
+void NumberTest()
+{
+    char str[16];
+
+    SSD1306_Clear();
+    TIM1->CNT = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        SSD1306_FillRect(0, 0, 128, 16, 0);
+        sprintf(str, "%d", i * 37);
+        SSD1306_DrawString(0, 0, str, 1);
+        sprintf(str, "%02d:%02d:%02d", i % 24, i % 60, (i * 7) % 60);
+        SSD1306_DrawString(0, 8, str, 1);
+    }
+    PrintElapsed("NumberTest sprintf x1000");
+
+    TIM1->CNT = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        SSD1306_FillRect(0, 0, 128, 16, 0);
+        SSD1306_DrawInt(0, 0, i * 37, 0, 1);
+        SSD1306_DrawTime(0, 8, i % 24, i % 60, (i * 7) % 60, 1);
+    }
+    PrintElapsed("NumberTest DrawInt x1000");
+
+    SSD1306_DrawFixed(0, 24, -2351, 2, 1);
+    SSD1306_Update();
+}
+
+// Flash size and blit time of the same converted image stored raw and RLE-compressed
+void ImageTest()
+{
+    SSD1306_Clear();
+
+    TIM1->CNT = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        SSD1306_DrawImage(0, 0, &image_sample_raw, SSD1306_BLIT_OPAQUE);
+    }
+    PrintElapsed("ImageTest raw x100");
+
+    TIM1->CNT = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        SSD1306_DrawImage(64, 0, &image_sample, SSD1306_BLIT_OPAQUE);
+    }
+    PrintElapsed("ImageTest RLE x100");
+    printf("ImageTest flash: raw %d bytes, RLE %d bytes\r\n", image_sample_raw.size, image_sample.size);
+
+    SSD1306_Update();
+    Delay_Ms(1000);
+
+    // The same static screen drawn and diffed through the buffer, then streamed straight from flash
+    SSD1306_Clear();
+    SSD1306_Update();
+    TIM1->CNT = 0;
+    SSD1306_DrawImage(0, 0, &image_sample_raw, SSD1306_BLIT_OPAQUE);
+    SSD1306_Update();
+    PrintElapsed("ImageTest draw+update");
+
+    SSD1306_Clear();
+    SSD1306_Update();
+    TIM1->CNT = 0;
+    SSD1306_StreamImage(0, 0, &image_sample_raw, SSD1306_STREAM_SHADOW);
+    PrintElapsed("ImageTest stream");
+}
+
+// Play the delta-coded spinner for 5 loops: stream bytes per frame and decode + transfer time
+void AnimTest()
+{
+    SSD1306_AnimPlayer player;
+    int frames = 0;
+
+    SSD1306_Clear();
+    SSD1306_DrawString(0, 0, "AnimTest", 1);
+    SSD1306_Update();
+
+    SSD1306_Anim_Start(&player, &anim_spinner);
+    TIM1->CNT = 0;
+    for (int i = 0; i < anim_spinner.frame_count * 5; i++)
+    {
+        SSD1306_Anim_NextFrame(&player, 48, 24);
+        SSD1306_UpdateDirty();
+        frames++;
+    }
+    int cnt = TIM1->CNT;
+    int fps100 = 1000000 * frames / cnt; // frames / (cnt * 0.1ms) in 1/100 fps
+    printf("AnimTest:%d frames %d.%dms, %d.%02dfps, %d bytes/frame\r\n", frames, cnt / 10, cnt % 10, fps100 / 100,
+           fps100 % 100, (int)(anim_spinner.size / anim_spinner.frame_count));
+}
@@ -5,26 +5,127 @@
 #include "ssd1306_HAL.h"
 #include "ssd1306_font.h"
 
-static uint8_t buffer1[SSD1306_WIDTH * SSD1306_HEIGHT / 8] = {0};
-static uint8_t buffer2[SSD1306_WIDTH * SSD1306_HEIGHT / 8] = {0};
+// Frame buffers: each page row is preceded by a slot for the I2C control byte, so a span goes out as one packet
+static uint8_t buffer1[SSD1306_FRAME_SIZE] = {0};
+static uint8_t buffer2[SSD1306_FRAME_SIZE] = {0};
+
+// Offset of column x of a page in a frame buffer
+#define FRAME_INDEX(page, x) ((page) * SSD1306_PAGE_STRIDE + 1 + (x))
 
 static uint8_t *buffer = buffer1;         // Current drawing buffer
 static uint8_t *display_buffer = buffer2; // Last displayed buffer
 
-// Force full update flag for initialization
-static uint8_t force_full_update = 1;
+// Pages whose panel contents the shadow does not describe (bit per page): after init, or streamed without
+// SSD1306_STREAM_SHADOW. Updates send them in full; SSD1306_UpdateStep() resumes the lowest one at stale_col
+#define ALL_PAGES ((uint8_t)((1u << (SSD1306_HEIGHT / 8)) - 1))
+static uint8_t stale_pages = ALL_PAGES;
+static uint8_t stale_col = 0;
+
+// Copy sent spans into display_buffer (cleared by SSD1306_Update_Swap(), which swaps the buffers instead)
+static uint8_t mirror_sent = 1;
+
+// Page flipping (SSD1306_Present / SSD1306_Acquire): buffer is the back buffer, display_buffer the front buffer
+static uint8_t present_mode = SSD1306_PRESENT_PRESERVE;
+static uint8_t back_ready = 1;        // buffer may be drawn into
+static uint8_t *pending_buffer = 0;   // Presented frame whose transfer has not started yet
+static uint8_t *spare_buffers[2];     // Buffers free to become the next back buffer
+static uint8_t spare_count = 0;
+
+// Transfer of the front buffer, advanced packet by packet by SSD1306_Poll()
+static uint8_t flip_start[SSD1306_HEIGHT / 8]; // Column span per page (end exclusive, start == end = unchanged)
+static uint8_t flip_end[SSD1306_HEIGHT / 8];
+static uint8_t flip_page = SSD1306_HEIGHT / 8; // Next page to send (all sent = idle)
+static uint8_t flip_window_sent = 0;           // Address window of flip_page already sent
+static uint8_t flip_window[1 + SSD1306_QUEUE_MAX_BYTES + 8]; // Control byte, queued commands and address window (must outlive the transfer)
+static uint8_t *borrowed = 0;                  // Byte in front of the span in flight, holding the control byte
+static uint8_t borrowed_value;
+
+// Display settings queued by SSD1306_SetContrast() etc. until the next command transaction, one slot per
+// setting so repeated calls coalesce (a slot set back to what the panel shows is dropped)
+#define SETTING_CONTRAST 0 // Contrast value (sent after SSD1306_CMD_SET_CONTRAST)
+#define SETTING_ENTIRE 1   // SSD1306_CMD_SET_DISPLAY_ALL_NORMAL / _ALL_ON
+#define SETTING_INVERSE 2  // SSD1306_CMD_SET_NORMAL_DISPLAY / _INVERSE_DISPLAY
+#define SETTING_POWER 3    // SSD1306_CMD_SET_DISPLAY_OFF / _ON
+#define SETTING_COUNT 4
+
+static uint8_t panel_setting[SETTING_COUNT]; // As last sent to the panel
+static uint8_t queued_setting[SETTING_COUNT];
+static uint8_t queued_mask = 0; // Bit per setting waiting to be sent
+
+// Memory addressing modes used for transfers (argument of SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE)
+#define ADDRESSING_HORIZONTAL 0x00 // One page span per window
+#define ADDRESSING_VERTICAL 0x01   // A box of pages sent column by column (narrow, tall changes)
+
+// Controller addressing mode, window and pointer as left by the commands and data sent so far
+typedef struct
+{
+    uint8_t known; // Cleared by SSD1306_Init() until the first window is set
+    uint8_t mode;
+    uint8_t col_start;
+    uint8_t col_end;
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t col; // Pointer
+    uint8_t page;
+} window_state_t;
+
+static window_state_t window = {0};
+
+// Data packet of a vertical box, gathered column by column (control byte first)
+static uint8_t vertical_packet[1 + SSD1306_VERTICAL_MAX_BYTES];
+
+// Clip window in screen coordinates applied by every primitive (x0/y0 inclusive, x1/y1 exclusive)
+static uint8_t clip_x0 = 0;
+static uint8_t clip_y0 = 0;
+static uint8_t clip_x1 = SSD1306_WIDTH;
+static uint8_t clip_y1 = SSD1306_HEIGHT;
+
+// Translation added to the coordinates of every draw call
+static int16_t origin_x = 0;
+static int16_t origin_y = 0;
+
+// Pattern applied by the fill primitives (8 column bytes, indexed by x & 7; NULL = solid)
+static const uint8_t *fill_pattern = 0;
+
+// Built-in fill patterns (SSD1306_PATTERN_*), anchored to screen coordinates so adjacent fills line up
+static const uint8_t fill_patterns[][8] = {
+    {0x55, 0x00, 0xAA, 0x00, 0x55, 0x00, 0xAA, 0x00}, // 25%
+    {0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA}, // 50%
+    {0xAA, 0xFF, 0x55, 0xFF, 0xAA, 0xFF, 0x55, 0xFF}, // 75%
+    {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80}, // Diagonal hatch
+    {0x81, 0x42, 0x24, 0x18, 0x18, 0x24, 0x42, 0x81}, // Cross hatch
+};
+
+static void flush_present(void);
+
+// Column extents tagged by SSD1306_InvalidatePriority(), sent first by SSD1306_UpdateStep()
+static uint8_t priority_start[SSD1306_HEIGHT / 8] = {0};
+static uint8_t priority_end[SSD1306_HEIGHT / 8] = {0};
+
+// Page where SSD1306_UpdateStep() continues with the unprioritized changes (round robin)
+static uint8_t step_page = 0;
+
+// Per-page column extents marked by SSD1306_Invalidate() (end exclusive, start == end = clean)
+static uint8_t dirty_start[SSD1306_HEIGHT / 8] = {0};
+static uint8_t dirty_end[SSD1306_HEIGHT / 8] = {0};
 
 //Frame Rate = 470k/(DCLK * MUX * CONTRAST)
 
 void SSD1306_Buffer_swap(void)
 {
-    // Swap drawing and display buffers
-    uint8_t *temp = buffer;
-    buffer = display_buffer;
-    display_buffer = temp;
+    // Flip: the drawn frame goes to the panel and drawing continues in the other buffer
+    SSD1306_Present();
+    SSD1306_Acquire(1);
+}
 
-    // Reset force update flag
-    force_full_update = 0;
+// Display settings as left by the init sequence, with nothing queued
+static void reset_panel_state(void)
+{
+    panel_setting[SETTING_CONTRAST] = 0x8F;
+    panel_setting[SETTING_ENTIRE] = SSD1306_CMD_SET_DISPLAY_ALL_NORMAL;
+    panel_setting[SETTING_INVERSE] = SSD1306_CMD_SET_NORMAL_DISPLAY;
+    panel_setting[SETTING_POWER] = SSD1306_CMD_SET_DISPLAY_ON;
+    queued_mask = 0;
 }
 
 void SSD1306_Init(void)
@@ -80,775 +181,3085 @@ void SSD1306_Init(void)
     tx_buffer[5] = SSD1306_CMD_SET_DISPLAY_ON;         // Turn on the display
     SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 6);
 
+    reset_panel_state();
+    window.known = 0;
+
     // Initialize buffers
     SSD1306_Clear();
-    force_full_update = 1; // Force first update to be full
+    stale_pages = ALL_PAGES; // Force first update to be full
+    stale_col = 0;
+    SSD1306_Update();
+}
+
+// The whole init sequence of SSD1306_InitFast(), ending with a full-screen window (display stays off)
+static const uint8_t fast_init_commands[] = {
+    SSD1306_CMD_SET_DISPLAY_OFF,
+    SSD1306_CMD_SET_COM_PINS_HARDWARE_CONFIGURATION, (SSD1306_HEIGHT == 64) ? 0x12 : 0x02,
+    SSD1306_CMD_SET_VCOMH_DESELECT_LEVEL, 0x50,
+    SSD1306_CMD_SET_DISPLAY_CLOCK_DIVIDE_RATIO, 0xF0,
+    SSD1306_CMD_SET_CHARGE_PUMP, 0x14,
+    SSD1306_CMD_SET_PRECHARGE_PERIOD, 0x11,
+    SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE, ADDRESSING_HORIZONTAL,
+    SSD1306_CMD_SET_SEGMENT_REMAP_INVERSE,
+    SSD1306_CMD_SET_COM_SCAN_DIRECTION_INVERSE,
+    SSD1306_CMD_SET_DISPLAY_OFFSET, 0x00,
+    SSD1306_CMD_SET_LOWER_COLUMN_ADDRESS_OFFSET + 0x00,
+    SSD1306_CMD_SET_HIGHER_COLUMN_ADDRESS_OFFSET + 0x00,
+    SSD1306_CMD_SET_DISPLAY_START_LINE_OFFSET + 0x00,
+    SSD1306_CMD_SET_MULTIPLEX_RATIO, SSD1306_HEIGHT - 1,
+    SSD1306_CMD_SET_CONTRAST, 0x8F,
+    SSD1306_CMD_SET_DISPLAY_ALL_NORMAL,
+    SSD1306_CMD_SET_NORMAL_DISPLAY,
+    SSD1306_CMD_SET_SCROLL_STOP,
+    SSD1306_CMD_SET_COLUMN_ADDRESS, 0, SSD1306_WIDTH - 1,
+    SSD1306_CMD_SET_PAGE_ADDRESS, 0, SSD1306_HEIGHT / 8 - 1,
+};
+
+void SSD1306_InitFast(const SSD1306_Image *splash)
+{
+    uint8_t display_on = SSD1306_CMD_SET_DISPLAY_ON;
+
+    SSD1306_IIC_Init_HAL();
+#if SSD1306_INIT_DELAY_MS > 0
+    SSD1306_Delay_Ms_HAL(SSD1306_INIT_DELAY_MS); // Controller power-up before the first command
+#endif
+
+    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, (uint8_t *)fast_init_commands, sizeof(fast_init_commands));
+    reset_panel_state();
+    window.known = 1; // The sequence ends with the full-screen window, pointer at column 0 of page 0
+    window.mode = ADDRESSING_HORIZONTAL;
+    window.col_start = 0;
+    window.col_end = SSD1306_WIDTH - 1;
+    window.page_start = 0;
+    window.page_end = SSD1306_HEIGHT / 8 - 1;
+    window.col = 0;
+    window.page = 0;
+
+    // Write the whole GDDRAM while the panel is still dark, so the first lit frame is the splash (or blank)
+    SSD1306_Clear();
+    if (splash)
+    {
+        SSD1306_DrawImage((SSD1306_WIDTH - splash->width) / 2, (SSD1306_HEIGHT - splash->height) / 2, splash,
+                          SSD1306_BLIT_OPAQUE);
+    }
+    stale_pages = ALL_PAGES;
+    stale_col = 0;
     SSD1306_Update();
+
+    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, &display_on, 1);
+    SSD1306_IIC_Flush_HAL();
 }
 
 void SSD1306_Clear(void)
 {
-    memset(buffer, 0, SSD1306_BUFFER_SIZE);
+    memset(buffer, 0, SSD1306_FRAME_SIZE); // The control slots are only written while a span is sent
 }
 
-void SSD1306_Update(void)
+// Record a display setting for the next command transaction
+static void queue_setting(uint8_t setting, uint8_t value)
 {
-    if (force_full_update)
+    queued_setting[setting] = value;
+    if (value == panel_setting[setting])
     {
-        // Force full update on first call after init
-        SSD1306_Update_Full();
-        return;
+        queued_mask &= ~(1 << setting); // Back to what the panel shows
     }
+    else
+    {
+        queued_mask |= 1 << setting;
+    }
+}
 
-    // Compare buffers and find changed regions
-    uint8_t changed_pages[8] = {0}; // Track which pages have changes
-    uint8_t page_ranges[8][2];      // [page][0] = start_col, [page][1] = end_col
-    uint8_t has_changes = 0;
+// Write the queued settings as command bytes to cmd (at most SSD1306_QUEUE_MAX_BYTES) and return their count
+static uint8_t take_queued(uint8_t *cmd)
+{
+    uint8_t count = 0;
 
-    // Initialize page ranges
-    for (uint8_t p = 0; p < 8; p++)
+    for (uint8_t setting = 0; queued_mask; setting++)
     {
-        page_ranges[p][0] = SSD1306_WIDTH; // start_col (invalid initially)
-        page_ranges[p][1] = 0;             // end_col
+        if (!(queued_mask & (1 << setting)))
+            continue;
+        if (setting == SETTING_CONTRAST)
+            cmd[count++] = SSD1306_CMD_SET_CONTRAST;
+        cmd[count++] = queued_setting[setting];
+        panel_setting[setting] = queued_setting[setting];
+        queued_mask &= ~(1 << setting);
     }
+    return count;
+}
+
+// End of an update: send the queued settings no window command carried, then let the HAL submit what it batched
+static void finish_update(void)
+{
+    uint8_t cmd_buffer[SSD1306_QUEUE_MAX_BYTES];
+    uint8_t count = take_queued(cmd_buffer);
 
-    // Compare buffers byte by byte
-    for (uint16_t i = 0; i < SSD1306_BUFFER_SIZE; i++)
+    if (count)
     {
-        if (buffer[i] != display_buffer[i])
-        {
-            has_changes = 1;
+        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, count);
+    }
+    SSD1306_IIC_Flush_HAL();
+}
 
-            // Calculate page and column from buffer index
-            uint8_t page = i / SSD1306_WIDTH;
-            uint8_t col = i % SSD1306_WIDTH;
+// Write the commands that prepare the controller for data filling columns start_col..end_col of pages
+// first_page..last_page (horizontal: one page) to cmd (at most 8 bytes) and return their count.
+// A command that would leave the mode, window and pointer as they are is skipped, e.g. between full pages
+// or spans with the same columns on consecutive pages
+static uint8_t window_commands(uint8_t *cmd, uint8_t mode, uint8_t first_page, uint8_t last_page,
+                               uint8_t start_col, uint8_t end_col)
+{
+    uint8_t count = 0;
 
-            // Mark page as changed
-            changed_pages[page] = 1;
+    if (mode == ADDRESSING_HORIZONTAL)
+    {
+        last_page = SSD1306_HEIGHT / 8 - 1; // Open-ended so the next page follows without a command
+    }
 
-            // Update column range for this page
-            if (page_ranges[page][0] > col)
-                page_ranges[page][0] = col;
-            if (page_ranges[page][1] < col)
-                page_ranges[page][1] = col;
-        }
+    if (!window.known || window.mode != mode)
+    {
+        cmd[count++] = SSD1306_CMD_SET_MEMORY_ADDRESSING_MODE;
+        cmd[count++] = mode;
+        window.mode = mode;
+    }
+    if (!window.known || window.col_start != start_col || window.col_end != end_col || window.col != start_col)
+    {
+        cmd[count++] = SSD1306_CMD_SET_COLUMN_ADDRESS; // Also moves the column pointer to start_col
+        cmd[count++] = start_col;
+        cmd[count++] = end_col;
+        window.col_start = start_col;
+        window.col_end = end_col;
+    }
+    if (!window.known || window.page != first_page ||
+        (mode == ADDRESSING_VERTICAL && (window.page_start != first_page || window.page_end != last_page)))
+    {
+        cmd[count++] = SSD1306_CMD_SET_PAGE_ADDRESS; // Also moves the page pointer to first_page
+        cmd[count++] = first_page;
+        cmd[count++] = last_page;
+        window.page_start = first_page;
+        window.page_end = last_page;
     }
+    window.known = 1;
 
-    if (!has_changes)
+    // The data about to be sent fills the columns once: a horizontal span leaves the pointer at the start of
+    // the next page, a vertical box wraps back to its first column and page
+    window.col = start_col;
+    if (mode == ADDRESSING_HORIZONTAL)
+    {
+        window.page = (first_page == window.page_end) ? window.page_start : first_page + 1;
+    }
+    else
     {
-        return; // No changes to update
+        window.page = first_page;
     }
+    return count;
+}
 
-    uint8_t cmd_buffer[3];
+// Point the controller at columns start_col..end_col of pages first_page..last_page
+// Queued settings ride along in the same command transaction
+static void set_window(uint8_t mode, uint8_t first_page, uint8_t last_page, uint8_t start_col, uint8_t end_col)
+{
+    uint8_t cmd_buffer[SSD1306_QUEUE_MAX_BYTES + 8];
+    uint8_t count = take_queued(cmd_buffer);
 
-    // Update only changed pages
-    for (uint8_t page = 0; page < 8; page++)
+    count += window_commands(&cmd_buffer[count], mode, first_page, last_page, start_col, end_col);
+    if (count)
     {
-        if (!changed_pages[page])
-            continue;
+        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, count);
+    }
+}
 
-        uint8_t start_col = page_ranges[page][0];
-        uint8_t end_col = page_ranges[page][1];
-        uint8_t width = end_col - start_col + 1;
+// Send columns start_col..end_col of one page of src and mirror them into the display buffer
+// src is a frame buffer (stride SSD1306_PAGE_STRIDE, sent in place) or a plain page-major frame (stride SSD1306_WIDTH)
+static void send_page_range(const uint8_t *src, uint16_t stride, uint8_t page, uint8_t start_col, uint8_t end_col)
+{
+    uint8_t width = end_col - start_col + 1;
+    const uint8_t *span = &src[page * stride + (stride - SSD1306_WIDTH) + start_col];
 
-        // Set column address range for this page
-        cmd_buffer[0] = SSD1306_CMD_SET_COLUMN_ADDRESS;
-        cmd_buffer[1] = start_col;
-        cmd_buffer[2] = end_col;
-        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, 3);
+    set_window(ADDRESSING_HORIZONTAL, page, page, start_col, end_col);
 
-        // Set page address
-        cmd_buffer[0] = SSD1306_CMD_SET_PAGE_ADDRESS;
-        cmd_buffer[1] = page;
-        cmd_buffer[2] = page;
-        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, 3);
+    if (stride == SSD1306_PAGE_STRIDE)
+    {
+        // The byte in front of the span (the row's control slot or the column to its left) carries the control byte
+        uint8_t *packet = (uint8_t *)span - 1;
+        uint8_t saved = *packet;
 
-        // Send changed region data
-        uint16_t start_idx = page * SSD1306_WIDTH + start_col;
-        SSD1306_IIC_HAL(SSD1306_MODE_DATA, &buffer[start_idx], width);
+        *packet = SSD1306_MODE_DATA;
+        SSD1306_IIC_Packet_HAL(packet, width + 1);
+        *packet = saved;
+    }
+    else
+    {
+        SSD1306_IIC_HAL(SSD1306_MODE_DATA, (uint8_t *)span, width);
+    }
 
-        // Update display buffer for changed region
-        memcpy(&display_buffer[start_idx], &buffer[start_idx], width);
+    if (mirror_sent)
+    {
+        memcpy(&display_buffer[FRAME_INDEX(page, start_col)], span, width);
     }
 }
 
-// Full screen update writing all buffer data page by page
-void SSD1306_Update_Full(void)
+// Send columns start_col..end_col of pages first_page..last_page of src as one vertical addressing box
+static void send_box(const uint8_t *src, uint16_t stride, uint8_t first_page, uint8_t last_page,
+                     uint8_t start_col, uint8_t end_col)
 {
-    uint8_t cmd_buffer[3];
-
-    // Write all pages (0-7) with full width
-    for (uint8_t page = 0; page < 8; page++)
-    {
-        // Set column address range for full width
-        cmd_buffer[0] = SSD1306_CMD_SET_COLUMN_ADDRESS;
-        cmd_buffer[1] = 0;
-        cmd_buffer[2] = SSD1306_WIDTH - 1;
-        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, 3);
+    const uint8_t *rows = &src[stride - SSD1306_WIDTH];
+    uint16_t length = 1;
 
-        // Set page address for current page
-        cmd_buffer[0] = SSD1306_CMD_SET_PAGE_ADDRESS;
-        cmd_buffer[1] = page;
-        cmd_buffer[2] = page;
-        SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, cmd_buffer, 3);
+    set_window(ADDRESSING_VERTICAL, first_page, last_page, start_col, end_col);
 
-        // Send entire page data (128 bytes)
-        uint16_t start_idx = page * SSD1306_WIDTH;
-        SSD1306_IIC_HAL(SSD1306_MODE_DATA, &buffer[start_idx], SSD1306_WIDTH);
+    // Vertical addressing takes the bytes column by column
+    vertical_packet[0] = SSD1306_MODE_DATA;
+    for (uint8_t col = start_col; col <= end_col; col++)
+    {
+        for (uint8_t page = first_page; page <= last_page; page++)
+        {
+            vertical_packet[length++] = rows[page * stride + col];
+        }
+    }
+    SSD1306_IIC_Packet_HAL(vertical_packet, length);
 
-        // Update display buffer for this page
-        memcpy(&display_buffer[start_idx], &buffer[start_idx], SSD1306_WIDTH);
+    if (mirror_sent)
+    {
+        for (uint8_t page = first_page; page <= last_page; page++)
+        {
+            memcpy(&display_buffer[FRAME_INDEX(page, start_col)], &rows[page * stride + start_col], end_col - start_col + 1);
+        }
     }
+}
+
+// Bus bytes (address and control byte per transaction) of the window commands and data of one transfer,
+// estimated on the addressing state it would leave behind
+static uint16_t transfer_cost(uint8_t mode, uint8_t first_page, uint8_t last_page, uint8_t start_col, uint8_t end_col)
+{
+    uint8_t cmd[8];
+    uint8_t count = window_commands(cmd, mode, first_page, last_page, start_col, end_col);
 
-    // Reset force update flag
-    force_full_update = 0;
+    return (count ? 2 + count : 0) + 2 + (uint16_t)(end_col - start_col + 1) * (last_page - first_page + 1);
 }
 
-void SSD1306_DisplayOn(void)
+// Send the changed column span of each page of src (end exclusive, start == end = unchanged): page by page in
+// horizontal addressing, or as one vertical box over all of them when that costs fewer bus bytes
+static void send_spans(const uint8_t *src, uint16_t stride, const uint8_t *span_start, const uint8_t *span_end)
 {
-    uint8_t tx_buffer[1];
-    tx_buffer[0] = SSD1306_CMD_SET_DISPLAY_ON; // Set display to normal mode
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 1);
+    window_state_t saved = window;
+    uint8_t first_page = SSD1306_HEIGHT / 8;
+    uint8_t last_page = 0;
+    uint8_t start_col = SSD1306_WIDTH;
+    uint8_t end_col = 0;
+    uint16_t horizontal = 0;
+
+    for (uint8_t page = 0; page < SSD1306_HEIGHT / 8; page++)
+    {
+        if (span_start[page] == span_end[page])
+            continue;
+        if (first_page > page)
+            first_page = page;
+        last_page = page;
+        if (start_col > span_start[page])
+            start_col = span_start[page];
+        if (end_col < span_end[page])
+            end_col = span_end[page];
+        horizontal += transfer_cost(ADDRESSING_HORIZONTAL, page, page, span_start[page], span_end[page] - 1);
+    }
+    window = saved;
+    if (first_page > last_page)
+    {
+        return; // Nothing changed
+    }
+
+    // The box also covers the unchanged bytes between the spans, so it only wins for narrow, tall changes
+    if (first_page < last_page &&
+        (uint16_t)(end_col - start_col) * (last_page - first_page + 1) <= SSD1306_VERTICAL_MAX_BYTES &&
+        transfer_cost(ADDRESSING_VERTICAL, first_page, last_page, start_col, end_col - 1) < horizontal)
+    {
+        window = saved;
+        send_box(src, stride, first_page, last_page, start_col, end_col - 1);
+        return;
+    }
+    window = saved;
+
+    for (uint8_t page = first_page; page <= last_page; page++)
+    {
+        if (span_start[page] != span_end[page])
+            send_page_range(src, stride, page, span_start[page], span_end[page] - 1);
+    }
 }
 
-void SSD1306_DisplayOff(void)
+// Forget marked extents once the whole buffer has been compared or sent
+static void clear_dirty(void)
 {
-    uint8_t tx_buffer[1];
-    tx_buffer[0] = SSD1306_CMD_SET_DISPLAY_OFF; // Turn off the display
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 1);
+    memset(dirty_start, 0, sizeof(dirty_start));
+    memset(dirty_end, 0, sizeof(dirty_end));
 }
 
-void SSD1306_DisplayAllOn(void)
+// Send the column range of each page where src differs from what the panel shows
+static void update_from(const uint8_t *src, uint16_t stride)
 {
-    uint8_t tx_buffer[1];
-    tx_buffer[0] = SSD1306_CMD_SET_DISPLAY_ALL_ON;
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 1);
+    uint8_t span_start[SSD1306_HEIGHT / 8];
+    uint8_t span_end[SSD1306_HEIGHT / 8];
+
+    for (uint8_t page = 0; page < SSD1306_HEIGHT / 8; page++)
+    {
+        const uint8_t *row = &src[page * stride + (stride - SSD1306_WIDTH)];
+        const uint8_t *shown = &display_buffer[FRAME_INDEX(page, 0)];
+        uint8_t start_col = 0;
+        uint8_t end_col = SSD1306_WIDTH;
+
+        if (!(stale_pages & (1 << page)))
+        {
+            while (start_col < end_col && row[start_col] == shown[start_col])
+                start_col++;
+            while (end_col > start_col && row[end_col - 1] == shown[end_col - 1])
+                end_col--;
+        }
+        span_start[page] = start_col; // start == end: page unchanged
+        span_end[page] = end_col;
+    }
+
+    send_spans(src, stride, span_start, span_end);
+    stale_pages = 0;
+    stale_col = 0;
 }
 
-void SSD1306_DisplayNormal(void)
+void SSD1306_Update(void)
 {
-    uint8_t tx_buffer[2];
-    tx_buffer[0] = SSD1306_CMD_SET_NORMAL_DISPLAY;
-    tx_buffer[1] = SSD1306_CMD_SET_DISPLAY_ALL_NORMAL;
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 2);
+    flush_present();
+    clear_dirty(); // The full diff covers any marked extents
+
+    update_from(buffer, SSD1306_PAGE_STRIDE);
+    finish_update();
 }
 
-void SSD1306_DisplayInverse(void)
+void SSD1306_Update_Swap(void)
 {
-    uint8_t tx_buffer[1];
-    tx_buffer[0] = SSD1306_CMD_SET_INVERSE_DISPLAY; // Set inverse display
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 1);
+    uint8_t *temp = buffer;
+
+    // The sent drawing buffer becomes the shadow as a whole, so the spans are not copied
+    mirror_sent = 0;
+    SSD1306_Update();
+    mirror_sent = 1;
+
+    buffer = display_buffer;
+    display_buffer = temp;
 }
 
-void SSD1306_SetContrast(uint8_t contrast) {
-    // Set contrast control command
-    uint8_t tx_buffer[2];
-    tx_buffer[0] = SSD1306_CMD_SET_CONTRAST;
-    tx_buffer[1] = contrast; // Contrast value (0-255)
-    SSD1306_IIC_HAL(SSD1306_MODE_COMMAND, tx_buffer, 2);
+void SSD1306_UpdateFrom(const uint8_t *frame)
+{
+    flush_present();
+    update_from(frame, SSD1306_WIDTH);
+    finish_update();
 }
 
-void SSD1306_DrawPixel(uint8_t x, uint8_t y, uint8_t color)
+// Merge a rectangle (draw coordinates) into per-page column extents
+static void mark_extent(uint8_t *extent_start, uint8_t *extent_end, int16_t x, int16_t y, uint8_t width, uint8_t height)
 {
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    int16_t x1 = x + origin_x + width; // Screen coordinates, exclusive
+    int16_t y1 = y + origin_y + height;
+
+    x += origin_x;
+    y += origin_y;
+    if (x < 0)
+        x = 0;
+    if (y < 0)
+        y = 0;
+    if (x1 > SSD1306_WIDTH)
+        x1 = SSD1306_WIDTH;
+    if (y1 > SSD1306_HEIGHT)
+        y1 = SSD1306_HEIGHT;
+    if (x >= x1 || y >= y1)
     {
-        return; // Out of bounds
+        return; // Nothing on screen
     }
 
-    if (color)
-    {
-        buffer[x + (y / 8) * SSD1306_WIDTH] |= (1 << (y % 8)); // Set pixel
-    }
-    else
+    uint8_t end_col = x1;
+    uint8_t last_page = (y1 - 1) >> 3;
+
+    for (uint8_t page = y >> 3; page <= last_page; page++)
     {
-        buffer[x + (y / 8) * SSD1306_WIDTH] &= ~(1 << (y % 8)); // Clear pixel
+        if (extent_start[page] == extent_end[page])
+        {
+            extent_start[page] = x; // First extent on this page
+            extent_end[page] = end_col;
+            continue;
+        }
+        if (extent_start[page] > x)
+            extent_start[page] = x;
+        if (extent_end[page] < end_col)
+            extent_end[page] = end_col;
     }
 }
 
-void SSD1306_DrawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+void SSD1306_Invalidate(int16_t x, int16_t y, uint8_t width, uint8_t height)
+{
+    mark_extent(dirty_start, dirty_end, x, y, width, height);
+}
+
+void SSD1306_InvalidatePriority(int16_t x, int16_t y, uint8_t width, uint8_t height)
+{
+    mark_extent(priority_start, priority_end, x, y, width, height);
+}
+
+void SSD1306_UpdateDirty(void)
 {
+    flush_present();
+    for (uint8_t page = 0; page < SSD1306_HEIGHT / 8; page++)
+    {
+        uint8_t start_col = dirty_start[page];
+        uint8_t end_col = dirty_end[page];
+        const uint8_t *row = &buffer[FRAME_INDEX(page, 0)];
+        const uint8_t *shown = &display_buffer[FRAME_INDEX(page, 0)];
+
+        if (stale_pages & (1 << page))
+        {
+            dirty_start[page] = 0;
+            dirty_end[page] = SSD1306_WIDTH;
+            continue;
+        }
+
+        // Trim the marked extent to the bytes that actually differ (start == end: clean page or no real change)
+        while (start_col < end_col && row[start_col] == shown[start_col])
+            start_col++;
+        while (end_col > start_col && row[end_col - 1] == shown[end_col - 1])
+            end_col--;
+        dirty_start[page] = start_col;
+        dirty_end[page] = end_col;
+    }
 
-    // Fast Bresenham's algorithm with inline pixel drawing
-    int dx = (int)x1 - (int)x0;
-    int dy = (int)y1 - (int)y0;
-    int sx = (dx >= 0) ? 1 : -1;
-    int sy = (dy >= 0) ? 1 : -1;
-    dx = (dx >= 0) ? dx : -dx;
-    dy = (dy >= 0) ? dy : -dy;
+    send_spans(buffer, SSD1306_PAGE_STRIDE, dirty_start, dirty_end);
+    stale_pages = 0;
+    stale_col = 0;
+    clear_dirty();
+    finish_update();
+}
 
-    int err = (dx > dy ? dx : -dy) / 2;
-    int e2;
+static uint8_t update_step(uint16_t budget)
+{
+    flush_present();
 
-    while (1)
+    // Pass 0 sends the tagged extents, then the stale pages go out in full, then pass 1 sends every page
+    // starting where the last step ran out of budget
+    for (uint8_t pass = 0; pass < 2; pass++)
     {
-        // Inline pixel drawing for performance
-        if (x0 < SSD1306_WIDTH && y0 < SSD1306_HEIGHT)
+        while (pass && stale_pages)
         {
-            if (color)
+            uint8_t page = 0;
+
+            while (!(stale_pages & (1 << page)))
+                page++;
+            if (budget <= SSD1306_STEP_SPAN_OVERHEAD)
             {
-                buffer[x0 + (y0 / 8) * SSD1306_WIDTH] |= (1 << (y0 % 8));
+                return 0;
             }
-            else
+
+            // Columns before stale_col are on the panel and in the shadow, so drawing between steps is safe
+            uint8_t count = SSD1306_WIDTH - stale_col;
+            if (count > budget - SSD1306_STEP_SPAN_OVERHEAD)
+                count = budget - SSD1306_STEP_SPAN_OVERHEAD;
+            send_page_range(buffer, SSD1306_PAGE_STRIDE, page, stale_col, stale_col + count - 1);
+            budget -= count + SSD1306_STEP_SPAN_OVERHEAD;
+            stale_col += count;
+            if (stale_col < SSD1306_WIDTH)
             {
-                buffer[x0 + (y0 / 8) * SSD1306_WIDTH] &= ~(1 << (y0 % 8));
+                return 0;
             }
+            stale_pages &= ~(1 << page);
+            stale_col = 0;
         }
 
-        if (x0 == x1 && y0 == y1)
-            break;
-        e2 = err;
-        if (e2 > -dx)
-        {
-            err -= dy;
-            x0 += sx;
-        }
-        if (e2 < dy)
+        for (uint8_t i = 0; i < SSD1306_HEIGHT / 8; i++)
         {
-            err += dx;
-            y0 += sy;
+            uint8_t page = pass ? (step_page + i) % (SSD1306_HEIGHT / 8) : i;
+            uint8_t start_col = pass ? 0 : priority_start[page];
+            uint8_t end_col = pass ? SSD1306_WIDTH : priority_end[page];
+            const uint8_t *row = &buffer[FRAME_INDEX(page, 0)];
+            const uint8_t *shown = &display_buffer[FRAME_INDEX(page, 0)];
+
+            if (stale_pages & (1 << page))
+            {
+                continue; // Not comparable yet; its tagged extent waits for the page to be sent
+            }
+
+            while (start_col < end_col && row[start_col] == shown[start_col])
+                start_col++;
+            while (end_col > start_col && row[end_col - 1] == shown[end_col - 1])
+                end_col--;
+            if (start_col == end_col)
+            {
+                if (!pass)
+                    priority_start[page] = priority_end[page] = 0; // Tagged extent is on the panel
+                continue;
+            }
+
+            if (budget <= SSD1306_STEP_SPAN_OVERHEAD)
+            {
+                if (pass)
+                    step_page = page;
+                return 0; // Out of budget, resume here
+            }
+
+            // Send as much of the span as the budget allows; the shadow follows exactly what was sent
+            uint8_t count = end_col - start_col;
+            if (count > budget - SSD1306_STEP_SPAN_OVERHEAD)
+                count = budget - SSD1306_STEP_SPAN_OVERHEAD;
+            send_page_range(buffer, SSD1306_PAGE_STRIDE, page, start_col, start_col + count - 1);
+            budget -= count + SSD1306_STEP_SPAN_OVERHEAD;
+
+            if (start_col + count < end_col)
+            {
+                if (pass)
+                    step_page = page;
+                return 0;
+            }
+            if (!pass)
+                priority_start[page] = priority_end[page] = 0;
         }
     }
+
+    step_page = 0;
+    return 1;
 }
 
-void SSD1306_DrawRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color)
+uint8_t SSD1306_UpdateStep(uint16_t budget)
 {
-    // Draw the four sides of the rectangle
-    SSD1306_DrawLine(x, y, x + width - 1, y, color);                           // Top side
-    SSD1306_DrawLine(x + width - 1, y, x + width - 1, y + height - 1, color);  // Right side
-    SSD1306_DrawLine(x + width - 1, y + height - 1, x, y + height - 1, color); // Bottom side
-    SSD1306_DrawLine(x, y + height - 1, x, y, color);                          // Left side
+    uint8_t done = update_step(budget);
+
+    finish_update(); // Settings are not held back by the budget
+    return done;
 }
 
-void SSD1306_FillRect(uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t color)
+// Full screen update writing all buffer data page by page
+void SSD1306_Update_Full(void)
 {
-    // Fill the rectangle by drawing horizontal lines
-    for (uint8_t i = 0; i < height; i++)
+    flush_present();
+    // Write all pages (0-7) with full width
+    for (uint8_t page = 0; page < 8; page++)
     {
-        SSD1306_DrawLine(x, y + i, x + width - 1, y + i, color);
+        send_page_range(buffer, SSD1306_PAGE_STRIDE, page, 0, SSD1306_WIDTH - 1);
     }
+
+    stale_pages = 0;
+    stale_col = 0;
+    clear_dirty();
+    finish_update();
 }
 
-void SSD1306_DrawCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint8_t color)
+// Copy the column span of each page where src differs from dst
+static void copy_changed(uint8_t *dst, const uint8_t *src)
 {
-    int x = radius;
-    int y = 0;
-    int err = 1 - radius;
+    for (uint8_t page = 0; page < SSD1306_HEIGHT / 8; page++)
+    {
+        uint8_t *row = &dst[FRAME_INDEX(page, 0)];
+        const uint8_t *from = &src[FRAME_INDEX(page, 0)];
+        uint8_t start_col = 0;
+        uint8_t end_col = SSD1306_WIDTH;
+
+        while (start_col < end_col && row[start_col] == from[start_col])
+            start_col++;
+        if (start_col == end_col)
+            continue;
+        while (row[end_col - 1] == from[end_col - 1])
+            end_col--;
+        memcpy(&row[start_col], &from[start_col], end_col - start_col);
+    }
 
-    while (x >= y)
+    if (borrowed >= src && borrowed < src + SSD1306_FRAME_SIZE)
     {
-        SSD1306_DrawPixel(x0 + x, y0 + y, color);
-        SSD1306_DrawPixel(x0 + y, y0 + x, color);
-        SSD1306_DrawPixel(x0 - y, y0 + x, color);
-        SSD1306_DrawPixel(x0 - x, y0 + y, color);
-        SSD1306_DrawPixel(x0 - x, y0 - y, color);
-        SSD1306_DrawPixel(x0 - y, y0 - x, color);
-        SSD1306_DrawPixel(x0 + y, y0 - x, color);
-        SSD1306_DrawPixel(x0 + x, y0 - y, color);
+        dst[borrowed - src] = borrowed_value; // src is in flight: take the real pixel byte, not the control byte
+    }
+}
 
-        y++;
-        if (err < 0)
-        {
-            err += 2 * y + 1;
-        }
-        else
+// Make the pending frame the front buffer and plan the spans where it differs from the panel
+static void start_flip(void)
+{
+    uint8_t *shown = display_buffer;
+
+    for (uint8_t page = 0; page < SSD1306_HEIGHT / 8; page++)
+    {
+        const uint8_t *row = &pending_buffer[FRAME_INDEX(page, 0)];
+        const uint8_t *old = &shown[FRAME_INDEX(page, 0)];
+        uint8_t start_col = 0;
+        uint8_t end_col = SSD1306_WIDTH;
+
+        if (!(stale_pages & (1 << page)))
         {
-            x--;
-            err += 2 * (y - x) + 1;
+            while (start_col < end_col && row[start_col] == old[start_col])
+                start_col++;
+            while (end_col > start_col && row[end_col - 1] == old[end_col - 1])
+                end_col--;
         }
+        flip_start[page] = start_col;
+        flip_end[page] = end_col;
     }
+    stale_pages = 0;
+    stale_col = 0;
+
+    display_buffer = pending_buffer;
+    pending_buffer = 0;
+    spare_buffers[spare_count++] = shown; // The panel no longer needs the previous front buffer
+    flip_page = 0;
+    flip_window_sent = 0;
 }
 
-void SSD1306_FillCircle(uint8_t x0, uint8_t y0, uint8_t radius, uint8_t color)
+void SSD1306_Poll(void)
 {
-    int x = 0;
-    int y = radius;
-    int d = 1 - radius;
-
-    while (y >= x)
+    while (!SSD1306_IIC_Busy_HAL())
     {
-        // Draw horizontal lines between symmetric points
-        for (int i = x0 - x; i <= x0 + x; i++)
+        if (borrowed)
         {
-            SSD1306_DrawPixel(i, y0 + y, color);
-            SSD1306_DrawPixel(i, y0 - y, color);
+            *borrowed = borrowed_value; // The data packet is out
+            borrowed = 0;
         }
-        for (int i = x0 - y; i <= x0 + y; i++)
+
+        if (flip_page >= SSD1306_HEIGHT / 8)
         {
-            SSD1306_DrawPixel(i, y0 + x, color);
-            SSD1306_DrawPixel(i, y0 - x, color);
+            if (!pending_buffer)
+            {
+                if (queued_mask)
+                {
+                    // No frame to carry the queued settings
+                    flip_window[0] = SSD1306_MODE_COMMAND;
+                    SSD1306_IIC_Packet_Start_HAL(flip_window, 1 + take_queued(&flip_window[1]));
+                    continue;
+                }
+                SSD1306_IIC_Flush_HAL();
+                return; // Idle
+            }
+            start_flip();
+            continue;
         }
-        x++;
-        if (d < 0)
+
+        uint8_t start_col = flip_start[flip_page];
+        uint8_t end_col = flip_end[flip_page];
+
+        if (start_col == end_col)
         {
-            d += 2 * x + 1;
+            flip_page++; // Unchanged page
+            continue;
         }
-        else
+        if (!flip_window_sent)
         {
-            y--;
-            d += 2 * (x - y) + 1;
+            uint8_t count = 1 + take_queued(&flip_window[1]);
+
+            count += window_commands(&flip_window[count], ADDRESSING_HORIZONTAL, flip_page, flip_page, start_col,
+                                     end_col - 1);
+            flip_window_sent = 1;
+            if (count > 1)
+            {
+                flip_window[0] = SSD1306_MODE_COMMAND;
+                SSD1306_IIC_Packet_Start_HAL(flip_window, count);
+            }
+            continue;
         }
+
+        borrowed = &display_buffer[FRAME_INDEX(flip_page, start_col) - 1];
+        borrowed_value = *borrowed;
+        *borrowed = SSD1306_MODE_DATA;
+        flip_window_sent = 0;
+        flip_page++;
+        SSD1306_IIC_Packet_Start_HAL(borrowed, end_col - start_col + 1);
     }
 }
 
-void SSD1306_DrawEllipse(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+// Finish any flip transfer before a direct update uses the bus and the shadow buffer
+static void flush_present(void)
 {
-    // Fast parameter setup
-    int xc = x0 + (x1 >> 1);
-    int yc = y0 + (y1 >> 1);
-    int a = x1 >> 1;
-    int b = y1 >> 1;
+    while (pending_buffer || flip_page < SSD1306_HEIGHT / 8 || borrowed || SSD1306_IIC_Busy_HAL())
+    {
+        SSD1306_Poll();
+    }
+}
 
-    if (a == 0 && b == 0)
+void SSD1306_FlushCommands(void)
+{
+    flush_present();
+    finish_update();
+}
+
+void SSD1306_SetPresentMode(uint8_t mode, uint8_t *third_buffer)
+{
+    SSD1306_Acquire(1);
+    flush_present();
+
+    // Move the front and back buffers back onto the built-in buffers, then add the third one
+    uint8_t *front = (display_buffer == buffer1 || display_buffer == buffer2) ? display_buffer
+                     : (buffer == buffer1)                                   ? buffer2
+                                                                             : buffer1;
+    uint8_t *back = (front == buffer1) ? buffer2 : buffer1;
+    if (front != display_buffer)
+        memcpy(front, display_buffer, SSD1306_FRAME_SIZE);
+    if (back != buffer)
+        memcpy(back, buffer, SSD1306_FRAME_SIZE);
+    display_buffer = front;
+    buffer = back;
+
+    present_mode = mode;
+    spare_count = 0;
+    if (third_buffer)
     {
-        SSD1306_DrawPixel(xc, yc, color);
-        return;
+        memcpy(third_buffer, buffer, SSD1306_FRAME_SIZE);
+        spare_buffers[spare_count++] = third_buffer;
     }
-    if (a == 0)
+}
+
+void SSD1306_Present(void)
+{
+    if (!back_ready)
     {
-        SSD1306_DrawLine(xc, y0, xc, y0 + y1 - 1, color);
-        return;
+        return; // No back buffer acquired since the last present
     }
-    if (b == 0)
+    if (pending_buffer)
     {
-        SSD1306_DrawLine(x0, yc, x0 + x1 - 1, yc, color);
-        return;
+        spare_buffers[spare_count++] = pending_buffer; // Not started yet: replaced by the newer frame
     }
+    pending_buffer = buffer;
+    back_ready = 0;
+    clear_dirty();
+    SSD1306_Poll();
+}
 
-    // Optimized ellipse algorithm
-    register int x = 0, y = b;
-    register int a2 = a * a, b2 = b * b;
-    register int dx = 0, dy = (a2 << 1) * y;
-    register int err = b2 - a2 * b + (a2 >> 2);
-    register int xc_px, xc_mx, yc_py, yc_my;
-
-    // Region 1
+uint8_t SSD1306_Acquire(uint8_t wait)
+{
     do
     {
-        xc_px = xc + x;
-        xc_mx = xc - x;
-        yc_py = yc + y;
-        yc_my = yc - y;
-
-        SSD1306_DrawPixel(xc_px, yc_py, color);
-        SSD1306_DrawPixel(xc_mx, yc_py, color);
-        SSD1306_DrawPixel(xc_px, yc_my, color);
-        SSD1306_DrawPixel(xc_mx, yc_my, color);
-
-        if (err < 0)
+        if (back_ready)
         {
-            x++;
-            dx += (b2 << 1);
-            err += dx + b2;
+            return 1;
         }
-        else
+        SSD1306_Poll();
+        if (spare_count)
         {
-            x++;
-            y--;
-            dx += (b2 << 1);
-            dy -= (a2 << 1);
-            err += dx - dy + b2;
+            buffer = spare_buffers[--spare_count];
+            if (present_mode == SSD1306_PRESENT_PRESERVE)
+            {
+                // Bring the new back buffer up to the latest presented frame
+                copy_changed(buffer, pending_buffer ? pending_buffer : display_buffer);
+            }
+            back_ready = 1;
+            return 1;
         }
-    } while (dx < dy);
+    } while (wait);
 
-    // Region 2
-    err = b2 * (x + 1) * (x + 1) + a2 * (y - 1) * (y - 1) - a2 * b2;
-    while (y >= 0)
-    {
-        xc_px = xc + x;
-        xc_mx = xc - x;
-        yc_py = yc + y;
-        yc_my = yc - y;
+    return 0;
+}
 
-        SSD1306_DrawPixel(xc_px, yc_py, color);
-        SSD1306_DrawPixel(xc_mx, yc_py, color);
-        SSD1306_DrawPixel(xc_px, yc_my, color);
-        SSD1306_DrawPixel(xc_mx, yc_my, color);
+void SSD1306_DisplayOn(void)
+{
+    queue_setting(SETTING_POWER, SSD1306_CMD_SET_DISPLAY_ON);
+}
+
+void SSD1306_DisplayOff(void)
+{
+    queue_setting(SETTING_POWER, SSD1306_CMD_SET_DISPLAY_OFF);
+}
+
+void SSD1306_DisplayAllOn(void)
+{
+    queue_setting(SETTING_ENTIRE, SSD1306_CMD_SET_DISPLAY_ALL_ON);
+}
+
+void SSD1306_DisplayNormal(void)
+{
+    queue_setting(SETTING_INVERSE, SSD1306_CMD_SET_NORMAL_DISPLAY);
+    queue_setting(SETTING_ENTIRE, SSD1306_CMD_SET_DISPLAY_ALL_NORMAL);
+}
+
+void SSD1306_DisplayInverse(void)
+{
+    queue_setting(SETTING_INVERSE, SSD1306_CMD_SET_INVERSE_DISPLAY);
+}
+
+void SSD1306_SetContrast(uint8_t contrast) {
+    queue_setting(SETTING_CONTRAST, contrast); // Contrast value (0-255)
+}
+
+void SSD1306_SetClip(int16_t x, int16_t y, int16_t width, int16_t height)
+{
+    int32_t x1 = (int32_t)x + width;
+    int32_t y1 = (int32_t)y + height;
+
+    // Intersect with the screen; an empty window rejects everything
+    clip_x0 = (x < 0) ? 0 : (x > SSD1306_WIDTH) ? SSD1306_WIDTH : x;
+    clip_y0 = (y < 0) ? 0 : (y > SSD1306_HEIGHT) ? SSD1306_HEIGHT : y;
+    clip_x1 = (x1 < clip_x0) ? clip_x0 : (x1 > SSD1306_WIDTH) ? SSD1306_WIDTH : (uint8_t)x1;
+    clip_y1 = (y1 < clip_y0) ? clip_y0 : (y1 > SSD1306_HEIGHT) ? SSD1306_HEIGHT : (uint8_t)y1;
+}
+
+void SSD1306_ResetClip(void)
+{
+    clip_x0 = 0;
+    clip_y0 = 0;
+    clip_x1 = SSD1306_WIDTH;
+    clip_y1 = SSD1306_HEIGHT;
+}
+
+void SSD1306_SetOrigin(int16_t x, int16_t y)
+{
+    origin_x = x;
+    origin_y = y;
+}
+
+void SSD1306_GetOrigin(int16_t *x, int16_t *y)
+{
+    *x = origin_x;
+    *y = origin_y;
+}
+
+void SSD1306_SetFillPattern(uint8_t pattern)
+{
+    if (pattern == SSD1306_PATTERN_SOLID || pattern > sizeof(fill_patterns) / sizeof(fill_patterns[0]))
+    {
+        fill_pattern = 0; // Solid (unknown IDs also fall back to solid)
+        return;
+    }
+    fill_pattern = fill_patterns[pattern - 1];
+}
+
+void SSD1306_SetFillPatternBits(const uint8_t *pattern)
+{
+    fill_pattern = pattern;
+}
+
+// Internal color flag set by the fill primitives: their spans take the current fill pattern
+#define SPAN_PATTERNED 0x80
+
+static uint8_t fill_color(uint8_t color)
+{
+    return fill_pattern ? (uint8_t)(color | SPAN_PATTERNED) : color;
+}
+
+// Raster operation on count consecutive bytes of one page starting at column x (mask = rows to touch)
+static void write_bytes(uint8_t *dst, int16_t x, uint8_t count, uint8_t mask, uint8_t color)
+{
+    const uint8_t *pattern = (color & SPAN_PATTERNED) ? fill_pattern : 0;
+    uint8_t *end = dst + count;
+
+    color &= (uint8_t)~SPAN_PATTERNED;
+
+    if (pattern)
+    {
+        for (uint8_t phase = x & 7; dst < end; phase = (phase + 1) & 7)
+        {
+            uint8_t bits = mask & pattern[phase];
+            if (color == SSD1306_COLOR_INVERT)
+                *dst++ ^= bits;
+            else if (color)
+                *dst++ |= bits;
+            else
+                *dst++ &= (uint8_t)~bits;
+        }
+    }
+    else if (color == SSD1306_COLOR_INVERT)
+    {
+        while (dst < end)
+            *dst++ ^= mask;
+    }
+    else if (color)
+    {
+        while (dst < end)
+            *dst++ |= mask;
+    }
+    else
+    {
+        mask = (uint8_t)~mask;
+        while (dst < end)
+            *dst++ &= mask;
+    }
+}
+
+typedef void (*plot_fn_t)(int16_t x, int16_t y, uint8_t color);
+
+// Unchecked pixel write in screen coordinates; the caller has already clipped
+static void put_pixel(int16_t x, int16_t y, uint8_t color)
+{
+    uint8_t *dst = &buffer[FRAME_INDEX(y >> 3, x)];
+    uint8_t bit = (uint8_t)(1 << (y & 7));
+
+    if (color == SSD1306_COLOR_INVERT)
+        *dst ^= bit;
+    else if (color)
+        *dst |= bit;
+    else
+        *dst &= (uint8_t)~bit;
+}
+
+static void plot_clipped(int16_t x, int16_t y, uint8_t color)
+{
+    if (x < clip_x0 || x >= clip_x1 || y < clip_y0 || y >= clip_y1)
+    {
+        return; // Outside the clip window
+    }
+    put_pixel(x, y, color);
+}
+
+// Pixel writer for a primitive whose pixels all lie in [x0, x1] x [y0, y1] (inclusive):
+// NULL when it is entirely outside the clip window, the unchecked writer when entirely inside
+static plot_fn_t select_plotter(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+    if (x1 < clip_x0 || x0 >= clip_x1 || y1 < clip_y0 || y0 >= clip_y1)
+    {
+        return 0;
+    }
+    if (x0 >= clip_x0 && x1 < clip_x1 && y0 >= clip_y0 && y1 < clip_y1)
+    {
+        return put_pixel;
+    }
+    return plot_clipped;
+}
+
+// Span writer: fill row y from x0 to x1 (inclusive), clipped once
+static void fill_hspan(int16_t x0, int16_t x1, int16_t y, uint8_t color)
+{
+    if (y < clip_y0 || y >= clip_y1)
+    {
+        return; // Row outside the clip window
+    }
+    if (x0 < clip_x0)
+        x0 = clip_x0;
+    if (x1 >= clip_x1)
+        x1 = clip_x1 - 1;
+    if (x0 > x1)
+    {
+        return; // Empty span
+    }
+
+    write_bytes(&buffer[FRAME_INDEX(y >> 3, x0)], x0, x1 - x0 + 1, (uint8_t)(1 << (y & 7)), color);
+}
+
+// Span writer: fill column x from y0 to y1 (inclusive) with one masked write per page
+static void fill_vspan(int16_t x, int16_t y0, int16_t y1, uint8_t color)
+{
+    if (x < clip_x0 || x >= clip_x1)
+    {
+        return; // Column outside the clip window
+    }
+    if (y0 < clip_y0)
+        y0 = clip_y0;
+    if (y1 >= clip_y1)
+        y1 = clip_y1 - 1;
+    if (y0 > y1)
+    {
+        return; // Empty span
+    }
+
+    uint8_t first_page = y0 >> 3;
+    uint8_t last_page = y1 >> 3;
+    uint8_t *dst = &buffer[FRAME_INDEX(first_page, x)];
+
+    for (uint8_t page = first_page; page <= last_page; page++, dst += SSD1306_PAGE_STRIDE)
+    {
+        uint8_t mask = 0xFF;
+        if (page == first_page)
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        if (page == last_page)
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+
+        write_bytes(dst, x, 1, mask, color);
+    }
+}
+
+// Fill [x0, x1] x [y0, y1] (inclusive, screen coordinates): clip once, then one mask per page
+// Inverting a page-aligned area is a single XOR pass over its bytes
+static void fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    if (x0 < clip_x0)
+        x0 = clip_x0;
+    if (y0 < clip_y0)
+        y0 = clip_y0;
+    if (x1 >= clip_x1)
+        x1 = clip_x1 - 1;
+    if (y1 >= clip_y1)
+        y1 = clip_y1 - 1;
+    if (x0 > x1 || y0 > y1)
+    {
+        return; // Empty or outside the clip window
+    }
+
+    uint8_t first_page = y0 >> 3;
+    uint8_t last_page = y1 >> 3;
+    uint8_t count = x1 - x0 + 1;
+
+    for (uint8_t page = first_page; page <= last_page; page++)
+    {
+        uint8_t *dst = &buffer[FRAME_INDEX(page, x0)];
+        uint8_t mask = 0xFF;
+        if (page == first_page)
+            mask &= (uint8_t)(0xFF << (y0 & 7));
+        if (page == last_page)
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+
+        if (mask == 0xFF && (color == 0 || color == 1))
+        {
+            memset(dst, color ? 0xFF : 0x00, count); // Whole page rows, solid color
+        }
+        else
+        {
+            write_bytes(dst, x0, count, mask, color);
+        }
+    }
+}
+
+// Cohen-Sutherland outcode of a point against the clip window
+#define OUTCODE_LEFT 0x01
+#define OUTCODE_RIGHT 0x02
+#define OUTCODE_TOP 0x04
+#define OUTCODE_BOTTOM 0x08
+
+static uint8_t outcode(int16_t x, int16_t y)
+{
+    uint8_t code = 0;
+
+    if (x < clip_x0)
+        code |= OUTCODE_LEFT;
+    else if (x >= clip_x1)
+        code |= OUTCODE_RIGHT;
+    if (y < clip_y0)
+        code |= OUTCODE_TOP;
+    else if (y >= clip_y1)
+        code |= OUTCODE_BOTTOM;
+    return code;
+}
+
+// Floor and ceiling of a / b for b > 0
+static int64_t floor_div64(int64_t a, int64_t b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static int64_t ceil_div64(int64_t a, int64_t b)
+{
+    return (a >= 0) ? (a + b - 1) / b : -((-a) / b);
+}
+
+// Line in screen coordinates
+// Step k along the major axis sits at minor offset floor((2 * k * d_minor + d_major) / (2 * d_major)), so a clipped
+// line is entered at its first visible step with the exact error term and draws the same pixels as the unclipped one.
+// open_end leaves out the pixel at (x1, y1), so outline sides sharing a vertex toggle it once under INVERT
+static void draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color, uint8_t open_end)
+{
+    if (y0 == y1)
+    {
+        if (open_end)
+        {
+            if (x0 == x1)
+                return; // Nothing but the end pixel
+            x1 += (x0 < x1) ? -1 : 1;
+        }
+        fill_hspan((x0 < x1) ? x0 : x1, (x0 < x1) ? x1 : x0, y0, color);
+        return;
+    }
+    if (x0 == x1)
+    {
+        if (open_end)
+            y1 += (y0 < y1) ? -1 : 1;
+        fill_vspan(x0, (y0 < y1) ? y0 : y1, (y0 < y1) ? y1 : y0, color);
+        return;
+    }
+
+    uint8_t code0 = outcode(x0, y0);
+    uint8_t code1 = outcode(x1, y1);
+    if (code0 & code1)
+    {
+        return; // Both ends beyond the same edge
+    }
+
+    uint8_t steep = (y1 > y0 ? y1 - y0 : y0 - y1) > (x1 > x0 ? x1 - x0 : x0 - x1);
+    int16_t major0 = steep ? y0 : x0;
+    int16_t minor0 = steep ? x0 : y0;
+    int32_t d_major = steep ? y1 - y0 : x1 - x0;
+    int32_t d_minor = steep ? x1 - x0 : y1 - y0;
+    int8_t s_major = (d_major > 0) ? 1 : -1;
+    int8_t s_minor = (d_minor > 0) ? 1 : -1;
+    d_major *= s_major;
+    d_minor *= s_minor;
+
+    int32_t k0 = 0;
+    int32_t k1 = d_major - open_end;
+    int32_t err = d_major; // Error term at the first end: half a minor step
+    int16_t minor = minor0;
+
+    if (code0 | code1)
+    {
+        // Visible step range along the major axis
+        int16_t lo = steep ? clip_y0 : clip_x0;
+        int16_t hi = (steep ? clip_y1 : clip_x1) - 1;
+        int32_t a = (s_major > 0) ? lo - major0 : major0 - hi;
+        int32_t b = (s_major > 0) ? hi - major0 : major0 - lo;
+        if (a > k0)
+            k0 = a;
+        if (b < k1)
+            k1 = b;
+
+        // Minor offsets inside the window, converted to steps through the rounding formula
+        lo = steep ? clip_x0 : clip_y0;
+        hi = (steep ? clip_x1 : clip_y1) - 1;
+        a = (s_minor > 0) ? lo - minor0 : minor0 - hi;
+        b = (s_minor > 0) ? hi - minor0 : minor0 - lo;
+        int64_t first = ceil_div64(2 * (int64_t)d_major * a - d_major, 2 * (int64_t)d_minor);
+        int64_t last = floor_div64(2 * (int64_t)d_major * (b + 1) - d_major - 1, 2 * (int64_t)d_minor);
+        if (first > k0)
+            k0 = (int32_t)first;
+        if (last < k1)
+            k1 = (int32_t)last;
+
+        if (k0 > k1)
+        {
+            return; // Passes the window without touching it
+        }
+
+        // Entering the window part-way: error term and minor offset at step k0 (64-bit only on this path)
+        if (k0 > 0)
+        {
+            int64_t t = 2 * (int64_t)k0 * d_minor + d_major;
+            err = (int32_t)(t % (2 * d_major));
+            minor += s_minor * (int32_t)(t / (2 * d_major));
+        }
+    }
+
+    int16_t major = major0 + s_major * k0;
+
+    for (int32_t k = k0; k <= k1; k++)
+    {
+        if (steep)
+            put_pixel(minor, major, color);
+        else
+            put_pixel(major, minor, color);
+
+        major += s_major;
+        err += 2 * d_minor;
+        if (err >= 2 * d_major)
+        {
+            err -= 2 * d_major;
+            minor += s_minor;
+        }
+    }
+}
+
+void SSD1306_DrawPixel(int16_t x, int16_t y, uint8_t color)
+{
+    plot_clipped(x + origin_x, y + origin_y, color);
+}
+
+void SSD1306_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    draw_line(x0 + origin_x, y0 + origin_y, x1 + origin_x, y1 + origin_y, color, 0);
+}
+
+void SSD1306_DrawRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color)
+{
+    if (width == 0 || height == 0)
+    {
+        return; // Empty rectangle
+    }
+
+    x += origin_x;
+    y += origin_y;
+    int16_t right = x + width - 1;
+    int16_t bottom = y + height - 1;
+
+    // Draw the four sides of the rectangle, corners only once so XOR can undo it
+    fill_hspan(x, right, y, color); // Top side
+    if (height > 1)
+        fill_hspan(x, right, bottom, color); // Bottom side
+    if (height > 2)
+    {
+        fill_vspan(x, y + 1, bottom - 1, color); // Left side
+        if (width > 1)
+            fill_vspan(right, y + 1, bottom - 1, color); // Right side
+    }
+}
+
+void SSD1306_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color)
+{
+    if (width == 0 || height == 0)
+    {
+        return; // Empty rectangle
+    }
+
+    x += origin_x;
+    y += origin_y;
+    fill_rect(x, y, x + width - 1, y + height - 1, fill_color(color));
+}
+
+// Plot (cx +- dx, cy +- dy), skipping the mirror images that coincide on the axes
+static void plot_quadrants(plot_fn_t plot, int16_t cx, int16_t cy, int16_t dx, int16_t dy, uint8_t color)
+{
+    plot(cx + dx, cy + dy, color);
+    if (dx != 0)
+        plot(cx - dx, cy + dy, color);
+    if (dy != 0)
+    {
+        plot(cx + dx, cy - dy, color);
+        if (dx != 0)
+            plot(cx - dx, cy - dy, color);
+    }
+}
+
+void SSD1306_DrawCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    plot_fn_t plot = select_plotter(x0 - radius, y0 - radius, x0 + radius, y0 + radius);
+    if (plot == 0)
+    {
+        return; // Entirely outside the clip window
+    }
+
+    int x = radius;
+    int y = 0;
+    int err = 1 - radius;
+
+    while (x >= y)
+    {
+        plot_quadrants(plot, x0, y0, x, y, color);
+        if (x != y)
+            plot_quadrants(plot, x0, y0, y, x, color); // The diagonal point is shared by both octants
+
+        y++;
+        if (err < 0)
+        {
+            err += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
+    }
+}
+
+void SSD1306_FillCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    if (select_plotter(x0 - radius, y0 - radius, x0 + radius, y0 + radius) == 0)
+    {
+        return; // Entirely outside the clip window
+    }
+
+    int x = 0;
+    int y = radius;
+    int d = 1 - radius;
+
+    color = fill_color(color);
+
+    while (y >= x)
+    {
+        // Each row gets exactly one span: rows +-x on every step, rows +-y at their widest (just before y moves)
+        fill_hspan(x0 - y, x0 + y, y0 + x, color);
+        if (x != 0)
+            fill_hspan(x0 - y, x0 + y, y0 - x, color);
+        if (d >= 0 && y != x)
+        {
+            fill_hspan(x0 - x, x0 + x, y0 + y, color);
+            fill_hspan(x0 - x, x0 + x, y0 - y, color);
+        }
+
+        x++;
+        if (d < 0)
+        {
+            d += 2 * x + 1;
+        }
+        else
+        {
+            y--;
+            d += 2 * (x - y) + 1;
+        }
+    }
+}
+
+void SSD1306_DrawEllipse(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    // Fast parameter setup
+    int xc = x0 + (x1 >> 1);
+    int yc = y0 + (y1 >> 1);
+    int a = x1 >> 1;
+    int b = y1 >> 1;
+
+    plot_fn_t plot = select_plotter(xc - a, yc - b, xc + a, yc + b);
+    if (plot == 0)
+    {
+        return; // Entirely outside the clip window
+    }
+
+    if (a == 0 && b == 0)
+    {
+        plot(xc, yc, color);
+        return;
+    }
+    if (a == 0)
+    {
+        fill_vspan(xc, y0, y0 + y1 - 1, color);
+        return;
+    }
+    if (b == 0)
+    {
+        fill_hspan(x0, x0 + x1 - 1, yc, color);
+        return;
+    }
+
+    // Optimized ellipse algorithm
+    register int x = 0, y = b;
+    register int a2 = a * a, b2 = b * b;
+    register int dx = 0, dy = (a2 << 1) * y;
+    register int err = b2 - a2 * b + (a2 >> 2);
+
+    // Region 1
+    do
+    {
+        plot_quadrants(plot, xc, yc, x, y, color);
+
+        if (err < 0)
+        {
+            x++;
+            dx += (b2 << 1);
+            err += dx + b2;
+        }
+        else
+        {
+            x++;
+            y--;
+            dx += (b2 << 1);
+            dy -= (a2 << 1);
+            err += dx - dy + b2;
+        }
+    } while (dx < dy);
+
+    // Region 2
+    err = b2 * (x + 1) * (x + 1) + a2 * (y - 1) * (y - 1) - a2 * b2;
+    while (y >= 0)
+    {
+        plot_quadrants(plot, xc, yc, x, y, color);
 
         if (err > 0)
         {
-            y--;
-            dy -= (a2 << 1);
-            err -= dy + a2;
+            y--;
+            dy -= (a2 << 1);
+            err -= dy + a2;
+        }
+        else
+        {
+            x++;
+            y--;
+            dx += (b2 << 1);
+            dy -= (a2 << 1);
+            err += dx - dy + a2;
+        }
+    }
+}
+
+void SSD1306_FillEllipse(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    // Fast parameter setup
+    register int xc = x0 + (x1 >> 1);
+    register int yc = y0 + (y1 >> 1);
+    register int a = x1 >> 1;
+    register int b = y1 >> 1;
+
+    if (a == 0 || b == 0)
+        return;
+    if (select_plotter(xc - a, yc - b, xc + a, yc + b) == 0)
+        return; // Entirely outside the clip window
+
+    color = fill_color(color);
+
+    // Optimized fill using integer arithmetic
+    register int a2 = a * a, b2 = b * b;
+    register int y, dy, dx;
+    register long dy2, dx_squared;
+    int y_start = (y0 > clip_y0) ? y0 : clip_y0; // Only rows inside the clip window
+    int y_end = (y0 + y1 < clip_y1) ? y0 + y1 : clip_y1;
+
+    for (y = y_start; y < y_end; y++)
+    {
+        dy = y - yc;
+        dy2 = (long)dy * dy;
+
+        if (dy2 <= b2)
+        {
+            dx_squared = (long)a2 * (b2 - dy2) / b2;
+
+            // Fast integer square root approximation
+            dx = 0;
+            if (dx_squared > 0)
+            {
+                register long test = 1;
+                while (test <= dx_squared)
+                {
+                    dx++;
+                    test = (long)dx * dx;
+                }
+                dx--;
+            }
+
+            if (dx > 0)
+            {
+                fill_hspan(xc - dx, xc + dx, y, color);
+            }
+        }
+    }
+}
+
+void SSD1306_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+    x1 += origin_x;
+    y1 += origin_y;
+    x2 += origin_x;
+    y2 += origin_y;
+
+    if (x0 == x1 && x1 == x2 && y0 == y1 && y1 == y2)
+    {
+        plot_clipped(x0, y0, color); // All three sides are the end pixel
+        return;
+    }
+
+    // Draw the three sides without their end pixels, so each vertex is drawn once
+    draw_line(x0, y0, x1, y1, color, 1); // Side 1
+    draw_line(x1, y1, x2, y2, color, 1); // Side 2
+    draw_line(x2, y2, x0, y0, color, 1); // Side 3
+}
+
+// Columns draw_line lights in row y for line = {x0, y0, x1, y1}, as the run [*run_x0, *run_x1];
+// returns 0 when the line does not reach the row
+static uint8_t line_row_run(const int16_t line[4], int16_t y, int16_t *run_x0, int16_t *run_x1)
+{
+    int32_t dx = line[2] - line[0];
+    int32_t dy = line[3] - line[1];
+    int8_t sx = (dx < 0) ? -1 : 1;
+    int32_t m = (dy < 0) ? line[1] - y : y - line[1]; // Rows from the start towards the end
+    int32_t first, last;
+    dx *= sx;
+    dy = (dy < 0) ? -dy : dy;
+
+    if (m < 0 || m > dy)
+    {
+        return 0;
+    }
+    if (dy > dx)
+    {
+        // Steep: one pixel per row, at the minor offset of step m
+        first = last = (2 * m * dx + dy) / (2 * dy);
+    }
+    else if (dy == 0)
+    {
+        first = 0;
+        last = dx;
+    }
+    else
+    {
+        // Shallow: the steps whose minor offset floor((2 * k * dy + dx) / (2 * dx)) is m
+        first = (m == 0) ? 0 : ((2 * m - 1) * dx + 2 * dy - 1) / (2 * dy);
+        last = ((2 * m + 1) * dx - 1) / (2 * dy);
+        if (last > dx)
+            last = dx;
+    }
+
+    *run_x0 = line[0] + sx * ((sx > 0) ? first : last);
+    *run_x1 = line[0] + sx * ((sx > 0) ? last : first);
+    return 1;
+}
+
+// Scanline fill in screen coordinates; the columns the line `spine` (or NULL) lights in each row are left out,
+// so the line can be drawn over the triangle without toggling those pixels twice under INVERT
+static void fill_triangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color,
+                          const int16_t *spine)
+{
+    // Fast vertex sorting
+    register int tx, ty;
+    if (y0 > y1)
+    {
+        tx = x0;
+        x0 = x1;
+        x1 = tx;
+        ty = y0;
+        y0 = y1;
+        y1 = ty;
+    }
+    if (y1 > y2)
+    {
+        tx = x1;
+        x1 = x2;
+        x2 = tx;
+        ty = y1;
+        y1 = y2;
+        y2 = ty;
+    }
+    if (y0 > y1)
+    {
+        tx = x0;
+        x0 = x1;
+        x1 = tx;
+        ty = y0;
+        y0 = y1;
+        y1 = ty;
+    }
+
+    int16_t min_x = (x0 < x1) ? ((x0 < x2) ? x0 : x2) : ((x1 < x2) ? x1 : x2);
+    int16_t max_x = (x0 > x1) ? ((x0 > x2) ? x0 : x2) : ((x1 > x2) ? x1 : x2);
+    if (select_plotter(min_x, y0, max_x, y2) == 0)
+        return; // Entirely outside the clip window
+
+    // Precompute deltas to avoid division in loop
+    register int dy01 = y1 - y0, dy02 = y2 - y0, dy12 = y2 - y1;
+    register int dx01 = x1 - x0, dx02 = x2 - x0, dx12 = x2 - x1;
+
+    if (dy02 == 0)
+        return; // Degenerate triangle
+
+    color = fill_color(color);
+
+    // Fill triangle with optimized scanline, only over the rows inside the clip window
+    register int y, xa, xb;
+    int y_start = (y0 > clip_y0) ? y0 : clip_y0;
+    int y_end = (y2 < clip_y1 - 1) ? y2 : clip_y1 - 1;
+    for (y = y_start; y <= y_end; y++)
+    {
+        if (y <= y1 && dy01 != 0)
+        {
+            xa = x0 + dx01 * (y - y0) / dy01;
+        }
+        else if (dy12 != 0)
+        {
+            xa = x1 + dx12 * (y - y1) / dy12;
+        }
+        else
+        {
+            xa = x1;
+        }
+
+        xb = x0 + dx02 * (y - y0) / dy02;
+
+        if (xa > xb)
+        {
+            tx = xa;
+            xa = xb;
+            xb = tx;
+        }
+        if (xa == xb)
+            continue;
+
+        int16_t run_x0, run_x1;
+        if (spine && line_row_run(spine, y, &run_x0, &run_x1) && run_x0 <= xb && run_x1 >= xa)
+        {
+            if (run_x0 > xa)
+                fill_hspan(xa, run_x0 - 1, y, color);
+            if (run_x1 < xb)
+                fill_hspan(run_x1 + 1, xb, y, color);
+        }
+        else
+        {
+            fill_hspan(xa, xb, y, color);
+        }
+    }
+}
+
+void SSD1306_FillTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color)
+{
+    fill_triangle(x0 + origin_x, y0 + origin_y, x1 + origin_x, y1 + origin_y, x2 + origin_x, y2 + origin_y, color, NULL);
+}
+
+void SSD1306_DrawRoundRect(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    // Fast parameter calculation; the corner centers never cross so no pixel is drawn twice
+    register int right = x0 + x1 - 1, bottom = y0 + y1 - 1;
+    register int max_r = (x1 < y1) ? ((x1 - 1) >> 1) : ((y1 - 1) >> 1);
+    if (radius > max_r)
+        radius = max_r;
+
+    plot_fn_t plot = select_plotter(x0, y0, right, bottom);
+    if (plot == 0 || x1 == 0 || y1 == 0)
+        return; // Entirely outside the clip window or empty
+
+    register int r = radius;
+    register int cx1 = x0 + r, cy1 = y0 + r;
+    register int cx2 = right - r, cy2 = bottom - r;
+
+    // Straight sides between the corner arcs
+    fill_hspan(cx1 + 1, cx2 - 1, y0, color);
+    if (y1 > 1)
+        fill_hspan(cx1 + 1, cx2 - 1, bottom, color);
+    fill_vspan(x0, cy1 + 1, cy2 - 1, color);
+    if (x1 > 1)
+        fill_vspan(right, cy1 + 1, cy2 - 1, color);
+
+    // Corner arcs; the end points on a shared axis (1 pixel wide or high box) are left to the first corner
+    register int x = 0, y = r, d = 3 - (r << 1);
+
+    while (y >= x)
+    {
+        for (uint8_t octant = 0; octant < 2; octant++)
+        {
+            register int dx = octant ? y : x;
+            register int dy = octant ? x : y;
+
+            if (octant && x == y)
+                break; // Diagonal point is shared by both octants
+
+            plot(cx1 - dx, cy1 - dy, color);
+            if (cx2 != cx1 || dx != 0)
+                plot(cx2 + dx, cy1 - dy, color);
+            if (cy2 != cy1 || dy != 0)
+            {
+                plot(cx1 - dx, cy2 + dy, color);
+                if (cx2 != cx1 || dx != 0)
+                    plot(cx2 + dx, cy2 + dy, color);
+            }
+        }
+
+        if (d < 0)
+        {
+            d += (x << 2) + 6;
+            x++;
+        }
+        else
+        {
+            d += ((x - y) << 2) + 10;
+            x++;
+            y--;
+        }
+    }
+}
+
+void SSD1306_FillRoundRect(int16_t x0, int16_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color)
+{
+    x0 += origin_x;
+    y0 += origin_y;
+
+    // Fast parameter setup (same corner geometry as SSD1306_DrawRoundRect)
+    register int right = x0 + x1 - 1, bottom = y0 + y1 - 1;
+    register int max_r = (x1 < y1) ? ((x1 - 1) >> 1) : ((y1 - 1) >> 1);
+    if (radius > max_r)
+        radius = max_r;
+
+    if (x1 == 0 || y1 == 0 || select_plotter(x0, y0, right, bottom) == 0)
+        return; // Empty or entirely outside the clip window
+
+    register int r = radius;
+    register int cx1 = x0 + r, cy1 = y0 + r;
+    register int cx2 = right - r, cy2 = bottom - r;
+
+    color = fill_color(color);
+
+    // Full-width middle band
+    fill_rect(x0, cy1, right, cy2, color);
+
+    // Corner rows: one span joins the left and right corners, each row written once (see SSD1306_FillCircle)
+    register int x = 0, y = r, d = 3 - (r << 1);
+
+    while (y >= x)
+    {
+        if (x != 0)
+        {
+            fill_hspan(cx1 - y, cx2 + y, cy1 - x, color);
+            fill_hspan(cx1 - y, cx2 + y, cy2 + x, color);
+        }
+
+        if (d < 0)
+        {
+            d += (x << 2) + 6;
+            x++;
+        }
+        else
+        {
+            if (y != x)
+            {
+                fill_hspan(cx1 - x, cx2 + x, cy1 - y, color);
+                fill_hspan(cx1 - x, cx2 + x, cy2 + y, color);
+            }
+            d += ((x - y) << 2) + 10;
+            x++;
+            y--;
+        }
+    }
+}
+
+// Binary search of the code point sorted extended font
+static const uint8_t *find_extended_glyph(uint32_t codepoint)
+{
+    int lo = 0;
+    int hi = (int)(sizeof(extended_font) / sizeof(extended_font[0])) - 1;
+
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) >> 1;
+        uint16_t cp = extended_font[mid].codepoint;
+
+        if (cp == codepoint)
+            return extended_font[mid].bitmap;
+        if (cp < codepoint)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return 0; // Not found
+}
+
+// Resolve a code point to its 8x8 glyph, or NULL if the font has no glyph for it
+static const uint8_t *find_glyph(uint32_t codepoint)
+{
+    if (codepoint >= 32 && codepoint <= 126)
+    {
+        return ascii_font[codepoint - 32]; // Direct index for printable ASCII
+    }
+    if (codepoint < 0x80)
+    {
+        return 0; // Control characters
+    }
+    return find_extended_glyph(codepoint);
+}
+
+// Row mask of a page limited to the clip window rows (0 for pages off the screen)
+static uint8_t clip_page_mask(int16_t page)
+{
+    int16_t top = page * 8;
+    uint8_t mask = 0xFF;
+
+    if (page < 0 || page >= SSD1306_HEIGHT / 8)
+        return 0;
+    if (clip_y0 > top)
+        mask = (clip_y0 - top >= 8) ? 0 : (uint8_t)(mask << (clip_y0 - top));
+    if (clip_y1 < top + 8)
+        mask = (top + 8 - clip_y1 >= 8) ? 0 : (uint8_t)(mask & (0xFF >> (top + 8 - clip_y1)));
+    return mask;
+}
+
+// Merge source bits into one destination byte; cover selects the bits the bitmap owns
+static inline uint8_t blit_merge(uint8_t dst, uint8_t bits, uint8_t cover, uint8_t mode)
+{
+    switch (mode)
+    {
+    case SSD1306_BLIT_SET:
+        return dst | (bits & cover);
+    case SSD1306_BLIT_CLEAR:
+        return dst & (uint8_t)~(bits & cover);
+    case SSD1306_BLIT_XOR:
+        return dst ^ (bits & cover);
+    case SSD1306_BLIT_INVERTED:
+        bits = (uint8_t)~bits;
+        /* fall through */
+    default:
+        return (uint8_t)((dst & ~cover) | (bits & cover));
+    }
+}
+
+// Blit a page-major bitmap (rows of width bytes per 8-pixel page, LSB at top)
+// Each source byte is shifted into at most two destination pages, so cost is proportional to the bitmap size
+// mode is one of SSD1306_BLIT_*; SET/CLEAR are transparent and equal to the usual color values
+static void blit_page_major(int16_t x, int16_t y, const uint8_t *src, uint8_t width, uint8_t height, uint8_t mode)
+{
+    int16_t x_start = (x > clip_x0) ? x : clip_x0;
+    int16_t x_end = (x + width < clip_x1) ? x + width : clip_x1;
+
+    if (x_start >= x_end || y >= clip_y1 || y + height <= clip_y0 || height == 0)
+    {
+        return; // Out of bounds
+    }
+
+    uint8_t shift = y & 7;
+    int16_t dst_page = (y - shift) / 8; // Floor, also for negative y
+    uint8_t src_pages = (height + 7) >> 3;
+    uint8_t count = x_end - x_start;
+
+    src += x_start - x;
+
+    for (uint8_t p = 0; p < src_pages && dst_page + p < SSD1306_HEIGHT / 8; p++, src += width)
+    {
+        // Rows of this source page that belong to the bitmap, then the part of them inside the clip window
+        uint8_t mask = (p == src_pages - 1 && (height & 7)) ? (uint8_t)(0xFF >> (8 - (height & 7))) : 0xFF;
+        uint8_t lo_cover = (uint8_t)(mask << shift) & clip_page_mask(dst_page + p);
+        uint8_t hi_cover = shift ? (uint8_t)(mask >> (8 - shift)) & clip_page_mask(dst_page + p + 1) : 0;
+        int16_t base = FRAME_INDEX(dst_page + p, x_start); // Only used when the page is covered
+
+        if (lo_cover == 0xFF && hi_cover == 0 && (mode == SSD1306_BLIT_OPAQUE || mode == SSD1306_BLIT_INVERTED))
+        {
+            // Aligned whole page: plain copy
+            uint8_t *lo = &buffer[base];
+            if (mode == SSD1306_BLIT_OPAQUE)
+            {
+                memcpy(lo, src, count);
+            }
+            else
+            {
+                for (uint8_t c = 0; c < count; c++)
+                    lo[c] = (uint8_t)~src[c];
+            }
+            continue;
+        }
+
+        if (lo_cover)
+        {
+            uint8_t *lo = &buffer[base];
+            for (uint8_t c = 0; c < count; c++)
+                lo[c] = blit_merge(lo[c], (uint8_t)(src[c] << shift), lo_cover, mode);
+        }
+        if (hi_cover)
+        {
+            uint8_t *hi = &buffer[base + SSD1306_PAGE_STRIDE];
+            for (uint8_t c = 0; c < count; c++)
+                hi[c] = blit_merge(hi[c], (uint8_t)(src[c] >> (8 - shift)), hi_cover, mode);
+        }
+    }
+}
+
+// Transpose an 8x8 bit block: row r bit c (LSB = left) becomes column c bit r (LSB = top)
+static void transpose8(const uint8_t *rows, uint8_t stride, uint8_t row_count, uint8_t *columns)
+{
+    uint32_t lo = 0; // Rows 0-3, one per byte
+    uint32_t hi = 0; // Rows 4-7
+    uint32_t t;
+
+    for (uint8_t r = 0; r < row_count; r++, rows += stride)
+    {
+        if (r < 4)
+            lo |= (uint32_t)*rows << (r * 8);
+        else
+            hi |= (uint32_t)*rows << ((r - 4) * 8);
+    }
+
+    // Swap 1x1, then 2x2 elements across the diagonal inside each 4x4 block
+    t = (lo ^ (lo >> 7)) & 0x00AA00AA;
+    lo ^= t ^ (t << 7);
+    t = (hi ^ (hi >> 7)) & 0x00AA00AA;
+    hi ^= t ^ (t << 7);
+    t = (lo ^ (lo >> 14)) & 0x0000CCCC;
+    lo ^= t ^ (t << 14);
+    t = (hi ^ (hi >> 14)) & 0x0000CCCC;
+    hi ^= t ^ (t << 14);
+
+    // Swap the off-diagonal 4x4 blocks
+    t = (lo & 0x0F0F0F0F) | ((hi << 4) & 0xF0F0F0F0);
+    hi = (hi & 0xF0F0F0F0) | ((lo >> 4) & 0x0F0F0F0F);
+    lo = t;
+
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        columns[c] = (uint8_t)(lo >> (c * 8));
+        columns[c + 4] = (uint8_t)(hi >> (c * 8));
+    }
+}
+
+// Blit a row-major (XBM) bitmap: each 8-row band is transposed into a page-major strip and sent to the page blitter
+static void blit_row_major(int16_t x, int16_t y, const uint8_t *src, uint8_t width, uint8_t height, uint8_t mode)
+{
+    uint8_t strip[SSD1306_WIDTH + 8];
+    uint8_t stride = (width + 7) >> 3;
+    int16_t vis_start = (clip_x0 > x) ? clip_x0 - x : 0; // Visible source columns
+    int16_t vis_end = (x + width < clip_x1) ? width : clip_x1 - x;
+
+    if (vis_start >= vis_end || height == 0)
+    {
+        return; // Out of bounds
+    }
+
+    // Only transpose the 8-column groups that reach the clip window
+    uint8_t group_start = vis_start >> 3;
+    uint8_t group_end = (vis_end + 7) >> 3;
+    int16_t strip_x = x + group_start * 8;
+    uint8_t strip_width = vis_end - group_start * 8;
+
+    for (uint16_t row = 0; row < height; row += 8)
+    {
+        uint8_t rows = (height - row < 8) ? height - row : 8;
+
+        if (y + row >= clip_y1)
+            break;
+        if (y + row + rows <= clip_y0)
+            continue;
+
+        const uint8_t *band = src + row * stride;
+        for (uint8_t g = group_start; g < group_end; g++)
+        {
+            transpose8(band + g, stride, rows, &strip[(g - group_start) * 8]);
+        }
+        blit_page_major(strip_x, y + row, strip, strip_width, rows, mode);
+    }
+}
+
+void SSD1306_DrawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t color)
+{
+    uint8_t mode = (color == SSD1306_COLOR_INVERT) ? SSD1306_BLIT_XOR : color ? SSD1306_BLIT_SET : SSD1306_BLIT_CLEAR;
+    blit_page_major(x + origin_x, y + origin_y, bitmap, width, height, mode);
+}
+
+void SSD1306_DrawBitmapEx(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height, uint8_t format, uint8_t mode)
+{
+    x += origin_x;
+    y += origin_y;
+    if (format == SSD1306_BITMAP_ROW_MAJOR)
+    {
+        blit_row_major(x, y, bitmap, width, height, mode);
+    }
+    else
+    {
+        blit_page_major(x, y, bitmap, width, height, mode);
+    }
+}
+
+// PackBits decoder state: the stream is consumed strictly in order, so any prefix can be decoded on the fly
+typedef struct
+{
+    const uint8_t *src;
+    uint8_t literal; // Literal bytes left in the current packet
+    uint8_t repeat;  // Repeats left in the current packet
+    uint8_t value;   // Repeated byte
+} rle_reader_t;
+
+static uint8_t rle_next(rle_reader_t *rle)
+{
+    for (;;)
+    {
+        if (rle->repeat)
+        {
+            rle->repeat--;
+            return rle->value;
+        }
+        if (rle->literal)
+        {
+            rle->literal--;
+            return *rle->src++;
+        }
+
+        uint8_t control = *rle->src++;
+        if (control < 0x80)
+        {
+            rle->literal = control + 1; // 1-128 literal bytes follow
+        }
+        else if (control > 0x80)
+        {
+            rle->repeat = 257 - control; // Next byte repeated 2-128 times
+            rle->value = *rle->src++;
+        }
+        // 0x80 is a no-op packet
+    }
+}
+
+void SSD1306_DrawImage(int16_t x, int16_t y, const SSD1306_Image *image, uint8_t mode)
+{
+    x += origin_x;
+    y += origin_y;
+    if (image->encoding != SSD1306_IMAGE_RLE)
+    {
+        blit_page_major(x, y, image->data, image->width, image->height, mode);
+        return;
+    }
+
+    // Decode one page row at a time into a strip of at most one screen width and blit it right away,
+    // so RAM use does not depend on the image size
+    uint8_t strip[SSD1306_WIDTH];
+    rle_reader_t rle = {image->data, 0, 0, 0};
+    uint8_t pages = (image->height + 7) >> 3;
+
+    for (uint8_t p = 0; p < pages; p++)
+    {
+        uint8_t rows = (p == pages - 1 && (image->height & 7)) ? (image->height & 7) : 8;
+        int16_t row_y = y + p * 8;
+
+        for (uint8_t col = 0; col < image->width;)
+        {
+            uint8_t count = (image->width - col < SSD1306_WIDTH) ? image->width - col : SSD1306_WIDTH;
+
+            for (uint8_t i = 0; i < count; i++)
+                strip[i] = rle_next(&rle);
+            blit_page_major(x + col, row_y, strip, count, rows, mode);
+            col += count;
+        }
+    }
+}
+
+// Send count bytes of row to columns x.. of one page, straight from where they are stored
+static void stream_row(uint8_t page, uint8_t x, const uint8_t *row, uint8_t count, uint8_t flags)
+{
+    set_window(ADDRESSING_HORIZONTAL, page, page, x, x + count - 1);
+    SSD1306_IIC_HAL(SSD1306_MODE_DATA, (uint8_t *)row, count);
+
+    if (flags & SSD1306_STREAM_SHADOW)
+    {
+        memcpy(&display_buffer[FRAME_INDEX(page, x)], row, count);
+    }
+    else
+    {
+        stale_pages |= 1 << page; // The next update sends the whole page
+        stale_col = 0;
+    }
+    if (flags & SSD1306_STREAM_BUFFER)
+    {
+        memcpy(&buffer[FRAME_INDEX(page, x)], row, count);
+    }
+}
+
+void SSD1306_StreamBitmap(uint8_t x, uint8_t page, const uint8_t *bitmap, uint8_t width, uint8_t pages, uint8_t flags)
+{
+    if (x >= SSD1306_WIDTH || page >= SSD1306_HEIGHT / 8 || width == 0)
+    {
+        return;
+    }
+    uint8_t count = (width < SSD1306_WIDTH - x) ? width : SSD1306_WIDTH - x;
+    if (pages > SSD1306_HEIGHT / 8 - page)
+        pages = SSD1306_HEIGHT / 8 - page;
+
+    flush_present();
+    for (uint8_t p = 0; p < pages; p++)
+    {
+        stream_row(page + p, x, &bitmap[(uint16_t)p * width], count, flags);
+    }
+    finish_update();
+}
+
+void SSD1306_StreamImage(uint8_t x, uint8_t page, const SSD1306_Image *image, uint8_t flags)
+{
+    uint8_t pages = (image->height + 7) >> 3;
+
+    if (image->encoding != SSD1306_IMAGE_RLE)
+    {
+        SSD1306_StreamBitmap(x, page, image->data, image->width, pages, flags);
+        return;
+    }
+    if (x >= SSD1306_WIDTH || page >= SSD1306_HEIGHT / 8 || image->width == 0)
+    {
+        return;
+    }
+    uint8_t count = (image->width < SSD1306_WIDTH - x) ? image->width : SSD1306_WIDTH - x;
+    if (pages > SSD1306_HEIGHT / 8 - page)
+        pages = SSD1306_HEIGHT / 8 - page;
+
+    // Decode one page row at a time; columns past the right edge are decoded and dropped
+    uint8_t strip[SSD1306_WIDTH];
+    rle_reader_t rle = {image->data, 0, 0, 0};
+
+    flush_present();
+    for (uint8_t p = 0; p < pages; p++)
+    {
+        for (uint8_t col = 0; col < image->width; col++)
+        {
+            uint8_t value = rle_next(&rle);
+            if (col < count)
+                strip[col] = value;
         }
-        else
+        stream_row(page + p, x, strip, count, flags);
+    }
+    finish_update();
+}
+
+void SSD1306_ReadBitmap(int16_t x, int16_t y, uint8_t *bitmap, uint8_t width, uint8_t height)
+{
+    uint8_t pages = (height + 7) >> 3;
+    uint8_t shift = (y + origin_y) & 7;
+    int16_t first_page = (y + origin_y - shift) / 8; // Floor, also for negative y
+
+    x += origin_x;
+    for (uint8_t p = 0; p < pages; p++, bitmap += width)
+    {
+        int16_t src_page = first_page + p;
+        uint8_t mask = (p == pages - 1 && (height & 7)) ? (uint8_t)(0xFF >> (8 - (height & 7))) : 0xFF;
+        const uint8_t *lo = (src_page >= 0 && src_page < SSD1306_HEIGHT / 8) ? &buffer[FRAME_INDEX(src_page, 0)] : NULL;
+        const uint8_t *hi = (shift && src_page + 1 >= 0 && src_page + 1 < SSD1306_HEIGHT / 8)
+                                ? &buffer[FRAME_INDEX(src_page + 1, 0)]
+                                : NULL;
+
+        for (uint8_t c = 0; c < width; c++)
         {
-            x++;
-            y--;
-            dx += (b2 << 1);
-            dy -= (a2 << 1);
-            err += dx - dy + a2;
+            int16_t col = x + c;
+            uint8_t bits = 0;
+
+            if (col >= 0 && col < SSD1306_WIDTH)
+            {
+                if (lo)
+                    bits = lo[col] >> shift;
+                if (hi)
+                    bits |= (uint8_t)(hi[col] << (8 - shift));
+            }
+            bitmap[c] = bits & mask; // Pixels outside the screen read as 0
         }
     }
 }
 
-void SSD1306_FillEllipse(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t color)
+// Draw one 8x8 glyph (column-major, LSB at top)
+static void draw_glyph(int16_t x, int16_t y, const uint8_t *font, uint8_t color)
 {
-    // Fast parameter setup
-    register int xc = x0 + (x1 >> 1);
-    register int yc = y0 + (y1 >> 1);
-    register int a = x1 >> 1;
-    register int b = y1 >> 1;
+    blit_page_major(x, y, font, 8, 8, color);
+}
 
-    if (a == 0 || b == 0)
-        return;
+// Bit-spread tables for scaled text: each nibble bit is repeated scale times (index = scale - 2)
+static const uint16_t bit_spread[3][16] = {
+    {0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF}, // 2x
+    {0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF}, // 3x
+    {0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF}, // 4x
+};
 
-    // Optimized fill using integer arithmetic
-    register int a2 = a * a, b2 = b * b;
-    register int y, dy, dx;
-    register long dy2, dx_squared;
+// Draw one 8x8 glyph enlarged by an integer scale (2-4)
+// Each source column expands into scale whole bytes per destination column, then goes through the page blitter
+static void draw_glyph_scaled(int16_t x, int16_t y, const uint8_t *font, uint8_t scale, uint8_t color)
+{
+    uint8_t scaled[4 * 32]; // Up to 4 pages of 32 columns
+    uint8_t width = scale * 8;
+    const uint16_t *spread = bit_spread[scale - 2];
 
-    for (y = y0; y < y0 + y1; y++)
+    for (uint8_t i = 0; i < 8; i++)
     {
-        dy = y - yc;
-        dy2 = (long)dy * dy;
+        uint32_t column = spread[font[i] & 0x0F] | ((uint32_t)spread[font[i] >> 4] << (scale * 4));
 
-        if (dy2 <= b2)
+        for (uint8_t p = 0; p < scale; p++, column >>= 8)
         {
-            dx_squared = (long)a2 * (b2 - dy2) / b2;
+            uint8_t *dst = &scaled[p * width + i * scale];
+            for (uint8_t r = 0; r < scale; r++)
+            {
+                dst[r] = (uint8_t)column; // Repeat the column horizontally
+            }
+        }
+    }
 
-            // Fast integer square root approximation
-            dx = 0;
-            if (dx_squared > 0)
+    blit_page_major(x, y, scaled, width, width, color);
+}
+
+uint32_t SSD1306_DecodeUTF8(const uint8_t **str)
+{
+    const uint8_t *s = *str;
+    uint32_t codepoint = s[0];
+    uint32_t min_codepoint;
+    uint8_t extra;
+
+    if (codepoint == 0)
+    {
+        return 0; // Terminator, pointer is not advanced
+    }
+
+    if (codepoint < 0x80)
+    {
+        *str = s + 1;
+        return codepoint;
+    }
+    else if ((codepoint & 0xE0) == 0xC0) // 110xxxxx
+    {
+        codepoint &= 0x1F;
+        extra = 1;
+        min_codepoint = 0x80;
+    }
+    else if ((codepoint & 0xF0) == 0xE0) // 1110xxxx
+    {
+        codepoint &= 0x0F;
+        extra = 2;
+        min_codepoint = 0x800;
+    }
+    else if ((codepoint & 0xF8) == 0xF0) // 11110xxx
+    {
+        codepoint &= 0x07;
+        extra = 3;
+        min_codepoint = 0x10000;
+    }
+    else
+    {
+        *str = s + 1; // Stray continuation byte or invalid lead byte
+        return SSD1306_UTF8_REPLACEMENT;
+    }
+
+    for (uint8_t i = 1; i <= extra; i++)
+    {
+        if ((s[i] & 0xC0) != 0x80)
+        {
+            // Truncated sequence: resume at the offending byte (never skips the terminator)
+            *str = s + i;
+            return SSD1306_UTF8_REPLACEMENT;
+        }
+        codepoint = (codepoint << 6) | (s[i] & 0x3F);
+    }
+    *str = s + extra + 1;
+
+    // Reject overlong forms, surrogates and values beyond U+10FFFF
+    if (codepoint < min_codepoint || codepoint > 0x10FFFF ||
+        (codepoint >= 0xD800 && codepoint <= 0xDFFF))
+    {
+        return SSD1306_UTF8_REPLACEMENT;
+    }
+    return codepoint;
+}
+
+void SSD1306_DrawChar(int16_t x, int16_t y, char c, uint8_t color)
+{
+    if (c < 32 || c > 126)
+    {
+        return; // Unsupported character
+    }
+
+    draw_glyph(x + origin_x, y + origin_y, ascii_font[c - 32], color);
+}
+
+// Draw UTF-8 character (Greek letters, special symbols)
+void SSD1306_DrawCharUTF8(int16_t x, int16_t y, const uint8_t *utf8_bytes, uint8_t color)
+{
+    const uint8_t *font = find_glyph(SSD1306_DecodeUTF8(&utf8_bytes));
+    if (font == 0)
+    {
+        return; // Character not found
+    }
+
+    draw_glyph(x + origin_x, y + origin_y, font, color);
+}
+
+void SSD1306_DrawString(int16_t x, int16_t y, const char *str, uint8_t color)
+{
+    x += origin_x;
+    y += origin_y;
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        return; // Out of bounds
+    }
+
+    const uint8_t *utf8_str = (const uint8_t *)str;
+
+    while (*utf8_str != 0) // Explicit check for null terminator
+    {
+        if (x >= SSD1306_WIDTH - 7) // Check for tight fit (8 pixels wide)
+        {
+            x = origin_x; // Move to next line if out of bounds
+            y += 8;
+            if (y >= SSD1306_HEIGHT - 7) // Check for tight vertical fit
             {
-                register long test = 1;
-                while (test <= dx_squared)
-                {
-                    dx++;
-                    test = (long)dx * dx;
-                }
-                dx--;
+                break; // Stop if out of vertical bounds
+            }
+        }
+
+        uint32_t codepoint = SSD1306_DecodeUTF8(&utf8_str);
+
+        if (codepoint < 32 || codepoint == 127)
+        {
+            continue; // Don't advance x position for control characters
+        }
+
+        // Unknown and malformed characters leave a blank cell
+        const uint8_t *font = find_glyph(codepoint);
+        if (font != 0)
+        {
+            draw_glyph(x, y, font, color);
+        }
+
+        x += 8; // Move to next character position (no gap)
+    }
+}
+
+const SSD1306_FontGlyph *SSD1306_FindFontGlyph(const SSD1306_Font *font, uint32_t codepoint)
+{
+    int lo = 0;
+    int hi = (int)font->glyph_count - 1;
+
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) >> 1;
+        uint16_t cp = font->glyphs[mid].codepoint;
+
+        if (cp == codepoint)
+            return &font->glyphs[mid];
+        if (cp < codepoint)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return 0; // Not found
+}
+
+// Draw one glyph of a proportional font in screen coordinates, returning its advance
+static uint8_t draw_char_font(int16_t x, int16_t y, const SSD1306_Font *font, uint32_t codepoint, uint8_t color)
+{
+    const SSD1306_FontGlyph *glyph = SSD1306_FindFontGlyph(font, codepoint);
+    if (glyph == 0)
+    {
+        return font->default_advance; // Missing glyphs leave a blank gap
+    }
+
+    blit_page_major(x, y, &font->bitmaps[glyph->offset], glyph->width, font->height, color);
+    return glyph->advance;
+}
+
+uint8_t SSD1306_DrawCharFont(int16_t x, int16_t y, const SSD1306_Font *font, uint32_t codepoint, uint8_t color)
+{
+    return draw_char_font(x + origin_x, y + origin_y, font, codepoint, color);
+}
+
+void SSD1306_DrawStringFont(int16_t x, int16_t y, const SSD1306_Font *font, const char *str, uint8_t color)
+{
+    x += origin_x;
+    y += origin_y;
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        return; // Out of bounds
+    }
+
+    const uint8_t *utf8_str = (const uint8_t *)str;
+
+    while (*utf8_str != 0)
+    {
+        uint32_t codepoint = SSD1306_DecodeUTF8(&utf8_str);
+
+        if (codepoint < 32 || codepoint == 127)
+        {
+            continue; // Don't advance x position for control characters
+        }
+
+        const SSD1306_FontGlyph *glyph = SSD1306_FindFontGlyph(font, codepoint);
+        uint8_t width = glyph ? glyph->width : font->default_advance;
+
+        if (x + width > SSD1306_WIDTH) // Glyph does not fit on this line
+        {
+            x = origin_x;
+            y += font->line_height;
+            if (y + font->height > SSD1306_HEIGHT)
+            {
+                break; // Stop if out of vertical bounds
             }
+        }
+
+        if (glyph != 0)
+        {
+            blit_page_major(x, y, &font->bitmaps[glyph->offset], glyph->width, font->height, color);
+            x += glyph->advance;
+        }
+        else
+        {
+            x += font->default_advance;
+        }
+    }
+}
+
+void SSD1306_DrawStringScaled(int16_t x, int16_t y, const char *str, uint8_t scale, uint8_t color)
+{
+    if (scale == 1)
+    {
+        SSD1306_DrawString(x, y, str, color);
+        return;
+    }
+
+    x += origin_x;
+    y += origin_y;
+    if (scale < 1 || scale > 4 || x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    {
+        return; // Unsupported scale or out of bounds
+    }
+
+    uint8_t cell = scale * 8;
+    const uint8_t *utf8_str = (const uint8_t *)str;
+
+    while (*utf8_str != 0)
+    {
+        if (x + cell > SSD1306_WIDTH) // Check for tight fit
+        {
+            x = origin_x; // Move to next line if out of bounds
+            y += cell;
+            if (y + cell > SSD1306_HEIGHT) // Check for tight vertical fit
+            {
+                break; // Stop if out of vertical bounds
+            }
+        }
+
+        uint32_t codepoint = SSD1306_DecodeUTF8(&utf8_str);
+
+        if (codepoint < 32 || codepoint == 127)
+        {
+            continue; // Don't advance x position for control characters
+        }
+
+        // Unknown and malformed characters leave a blank cell
+        const uint8_t *font = find_glyph(codepoint);
+        if (font != 0)
+        {
+            draw_glyph_scaled(x, y, font, scale, color);
+        }
+
+        x += cell;
+    }
+}
+
+// Advance of a code point in the given font (NULL = built-in 8x8 font)
+static uint8_t text_advance(const SSD1306_Font *font, uint32_t codepoint)
+{
+    if (font == 0)
+    {
+        return 8; // Unknown characters leave a blank cell
+    }
+
+    const SSD1306_FontGlyph *glyph = SSD1306_FindFontGlyph(font, codepoint);
+    return glyph ? glyph->advance : font->default_advance;
+}
+
+static void text_draw(int16_t x, int16_t y, const SSD1306_Font *font, uint32_t codepoint, uint8_t color)
+{
+    if (font == 0)
+    {
+        const uint8_t *glyph = find_glyph(codepoint);
+        if (glyph != 0)
+        {
+            draw_glyph(x, y, glyph, color);
+        }
+    }
+    else
+    {
+        draw_char_font(x, y, font, codepoint, color);
+    }
+}
+
+// Find the end of the line starting at str, breaking at '\n' and, when wrapping, at the last space that fits
+// Returns the line width; *end is where drawing stops and *next where the following line starts
+static uint16_t text_line(const uint8_t *str, const SSD1306_Font *font, uint8_t max_width, uint8_t wrap,
+                          const uint8_t **end, const uint8_t **next)
+{
+    const uint8_t *p = str;
+    const uint8_t *break_end = 0;
+    const uint8_t *break_next = 0;
+    uint16_t break_width = 0;
+    uint16_t width = 0;
+
+    while (*p != 0)
+    {
+        const uint8_t *q = p;
+        uint32_t codepoint = SSD1306_DecodeUTF8(&q);
+
+        if (codepoint == '\n')
+        {
+            *end = p;
+            *next = q;
+            return width;
+        }
+        if (codepoint < 32 || codepoint == 127)
+        {
+            p = q;
+            continue; // Control characters take no space
+        }
+
+        uint8_t advance = text_advance(font, codepoint);
+
+        if (codepoint == ' ')
+        {
+            break_end = p; // Candidate break: drop the space itself
+            break_next = q;
+            break_width = width;
+        }
 
-            if (dx > 0)
+        if (wrap && width + advance > max_width && p != str)
+        {
+            if (break_end != 0)
             {
-                SSD1306_DrawLine(xc - dx, y, xc + dx, y, color);
+                *end = break_end;
+                *next = break_next;
+                return break_width;
             }
+            *end = p; // Single word longer than the box: hard break
+            *next = p;
+            return width;
         }
+
+        width += advance;
+        p = q;
     }
-}
 
-void SSD1306_DrawTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color)
-{
-    // Draw the three sides of the triangle
-    SSD1306_DrawLine(x0, y0, x1, y1, color); // Side 1
-    SSD1306_DrawLine(x1, y1, x2, y2, color); // Side 2
-    SSD1306_DrawLine(x2, y2, x0, y0, color); // Side 3
+    *end = p;
+    *next = p;
+    return width;
 }
 
-void SSD1306_FillTriangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2, uint8_t color)
+uint16_t SSD1306_MeasureString(const SSD1306_Font *font, const char *str)
 {
-    // Fast vertex sorting
-    register int tx, ty;
-    if (y0 > y1)
-    {
-        tx = x0;
-        x0 = x1;
-        x1 = tx;
-        ty = y0;
-        y0 = y1;
-        y1 = ty;
-    }
-    if (y1 > y2)
+    const uint8_t *line = (const uint8_t *)str;
+    uint16_t widest = 0;
+
+    while (*line != 0)
     {
-        tx = x1;
-        x1 = x2;
-        x2 = tx;
-        ty = y1;
-        y1 = y2;
-        y2 = ty;
+        const uint8_t *end;
+        const uint8_t *next;
+        uint16_t width = text_line(line, font, 0, 0, &end, &next);
+
+        if (width > widest)
+            widest = width;
+        line = next;
     }
-    if (y0 > y1)
+    return widest;
+}
+
+uint8_t SSD1306_DrawTextBox(int16_t x, int16_t y, uint8_t width, uint8_t height, const SSD1306_Font *font,
+                            const char *str, uint8_t flags, uint8_t color)
+{
+    uint8_t glyph_height = font ? font->height : 8;
+    uint8_t line_height = font ? font->line_height : 8;
+    uint8_t wrap = flags & SSD1306_TEXT_WRAP;
+    uint8_t ellipsis = flags & SSD1306_TEXT_ELLIPSIS;
+    uint8_t align = flags & SSD1306_TEXT_ALIGN_MASK;
+    uint8_t ellipsis_width = 3 * text_advance(font, '.');
+    uint8_t lines = 0;
+
+    x += origin_x;
+    y += origin_y;
+    int16_t bottom = y + height;
+
+    if (width == 0 || height == 0 || x >= clip_x1 || x + width <= clip_x0 || y >= clip_y1 || bottom <= clip_y0)
     {
-        tx = x0;
-        x0 = x1;
-        x1 = tx;
-        ty = y0;
-        y0 = y1;
-        y1 = ty;
+        return 0; // Out of bounds
     }
 
-    // Precompute deltas to avoid division in loop
-    register int dy01 = y1 - y0, dy02 = y2 - y0, dy12 = y2 - y1;
-    register int dx01 = x1 - x0, dx02 = x2 - x0, dx12 = x2 - x1;
+    // Clip glyphs to the box inside the current clip window
+    uint8_t saved_x0 = clip_x0, saved_y0 = clip_y0, saved_x1 = clip_x1, saved_y1 = clip_y1;
+    if (x > clip_x0)
+        clip_x0 = x;
+    if (y > clip_y0)
+        clip_y0 = y;
+    if (x + width < clip_x1)
+        clip_x1 = x + width;
+    if (bottom < clip_y1)
+        clip_y1 = bottom;
+
+    const uint8_t *line = (const uint8_t *)str;
+    int16_t line_y = y;
+
+    while (*line != 0 && line_y < bottom)
+    {
+        const uint8_t *end;
+        const uint8_t *next;
+        uint16_t line_width = text_line(line, font, width, wrap, &end, &next);
+        uint8_t last_line = (line_y + line_height + glyph_height > bottom); // No room for another full line
+        uint8_t truncate = 0;
 
-    if (dy02 == 0)
-        return; // Degenerate triangle
+        if (ellipsis && (line_width > width || (last_line && *next != 0)))
+        {
+            truncate = 1;
+            line_width = width; // Truncated line fills the box
+        }
 
-    // Fill triangle with optimized scanline
-    register int y, xa, xb;
-    for (y = y0; y <= y2; y++)
-    {
-        if (y <= y1 && dy01 != 0)
+        // Alignment offset (overflowing lines are left aligned and clipped)
+        int16_t pen_x = x;
+        if (line_width < width)
         {
-            xa = x0 + dx01 * (y - y0) / dy01;
+            if (align == SSD1306_TEXT_ALIGN_CENTER)
+                pen_x += (width - line_width) / 2;
+            else if (align == SSD1306_TEXT_ALIGN_RIGHT)
+                pen_x += width - line_width;
         }
-        else if (dy12 != 0)
+
+        const uint8_t *p = line;
+        while (p < end && pen_x < clip_x1)
         {
-            xa = x1 + dx12 * (y - y1) / dy12;
+            uint32_t codepoint = SSD1306_DecodeUTF8(&p);
+            if (codepoint < 32 || codepoint == 127)
+            {
+                continue;
+            }
+
+            uint8_t advance = text_advance(font, codepoint);
+            if (truncate && pen_x + advance + ellipsis_width > x + width)
+            {
+                break; // Leave room for the ellipsis
+            }
+            text_draw(pen_x, line_y, font, codepoint, color);
+            pen_x += advance;
         }
-        else
+
+        if (truncate)
         {
-            xa = x1;
+            for (uint8_t i = 0; i < 3; i++)
+            {
+                text_draw(pen_x, line_y, font, '.', color);
+                pen_x += ellipsis_width / 3;
+            }
         }
 
-        xb = x0 + dx02 * (y - y0) / dy02;
+        lines++;
+        line_y += line_height;
+        line = next;
 
-        if (xa > xb)
+        if (truncate && last_line)
         {
-            tx = xa;
-            xa = xb;
-            xb = tx;
+            break; // Remaining text is represented by the ellipsis
         }
-        if (xa != xb)
-            SSD1306_DrawLine(xa, y, xb, y, color);
     }
+
+    clip_x0 = saved_x0;
+    clip_y0 = saved_y0;
+    clip_x1 = saved_x1;
+    clip_y1 = saved_y1;
+    return lines;
 }
 
-void SSD1306_DrawRoundRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color)
+// Draw the low digits of an unsigned value, at least min_digits wide (zero padded)
+static int16_t draw_digits(int16_t x, int16_t y, uint32_t value, uint8_t min_digits, uint8_t color)
 {
-    // Fast parameter calculation
-    register int right = x0 + x1 - 1, bottom = y0 + y1 - 1;
-    register int max_r = (x1 < y1) ? (x1 >> 1) : (y1 >> 1);
-    if (radius > max_r)
-        radius = max_r;
+    uint8_t digits[10]; // 2^32 has 10 decimal digits
+    uint8_t count = 0;
 
-    // Draw sides in one go
-    register int r = radius;
-    SSD1306_DrawLine(x0 + r, y0, right - r, y0, color);
-    SSD1306_DrawLine(right, y0 + r, right, bottom - r, color);
-    SSD1306_DrawLine(x0 + r, bottom, right - r, bottom, color);
-    SSD1306_DrawLine(x0, y0 + r, x0, bottom - r, color);
+    do
+    {
+        digits[count++] = value % 10;
+        value /= 10;
+    } while (value != 0 && count < sizeof(digits));
 
-    // Optimized corner drawing
-    register int x = 0, y = r, d = 3 - (r << 1);
-    register int cx1 = x0 + r, cy1 = y0 + r;
-    register int cx2 = right - r, cy2 = bottom - r;
+    while (count < min_digits && count < sizeof(digits))
+    {
+        digits[count++] = 0;
+    }
 
-    while (y >= x)
+    while (count != 0)
     {
-        // Draw all 8 corner pixels at once
-        SSD1306_DrawPixel(cx1 - x, cy1 - y, color);
-        SSD1306_DrawPixel(cx1 - y, cy1 - x, color);
-        SSD1306_DrawPixel(cx2 + x, cy1 - y, color);
-        SSD1306_DrawPixel(cx2 + y, cy1 - x, color);
-        SSD1306_DrawPixel(cx2 + x, cy2 + y, color);
-        SSD1306_DrawPixel(cx2 + y, cy2 + x, color);
-        SSD1306_DrawPixel(cx1 - x, cy2 + y, color);
-        SSD1306_DrawPixel(cx1 - y, cy2 + x, color);
+        draw_glyph(x, y, ascii_font['0' - 32 + digits[--count]], color);
+        x += 8;
+    }
+    return x;
+}
 
-        if (d < 0)
-        {
-            d += (x << 2) + 6;
-            x++;
-        }
-        else
-        {
-            d += ((x - y) << 2) + 10;
-            x++;
-            y--;
-        }
+int16_t SSD1306_DrawInt(int16_t x, int16_t y, int32_t value, uint8_t min_digits, uint8_t color)
+{
+    uint32_t magnitude = (uint32_t)value;
+
+    x += origin_x;
+    y += origin_y;
+
+    if (value < 0)
+    {
+        draw_glyph(x, y, ascii_font['-' - 32], color);
+        x += 8;
+        magnitude = 0U - magnitude;
     }
+    return draw_digits(x, y, magnitude, min_digits, color) - origin_x;
 }
 
-void SSD1306_FillRoundRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t radius, uint8_t color)
+int16_t SSD1306_DrawFixed(int16_t x, int16_t y, int32_t value, uint8_t decimals, uint8_t color)
 {
-    // Fast parameter setup
-    register int right = x0 + x1 - 1, bottom = y0 + y1 - 1;
-    register int max_r = (x1 < y1) ? (x1 >> 1) : (y1 >> 1);
-    if (radius > max_r)
-        radius = max_r;
+    static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    uint32_t magnitude = (uint32_t)value;
 
-    register int r = radius;
+    x += origin_x;
+    y += origin_y;
 
-    // Fill main areas quickly
-    SSD1306_FillRect(x0, y0 + r, x1, y1 - (r << 1), color);
-    SSD1306_FillRect(x0 + r, y0, x1 - (r << 1), r, color);
-    SSD1306_FillRect(x0 + r, bottom - r + 1, x1 - (r << 1), r, color);
+    if (decimals > 9)
+    {
+        decimals = 9;
+    }
+    if (value < 0)
+    {
+        draw_glyph(x, y, ascii_font['-' - 32], color);
+        x += 8;
+        magnitude = 0U - magnitude;
+    }
 
-    // Optimized corner filling
-    register int x = 0, y = r, d = 3 - (r << 1);
-    register int cx1 = x0 + r, cy1 = y0 + r;
-    register int cx2 = right - r, cy2 = bottom - r;
+    x = draw_digits(x, y, magnitude / pow10[decimals], 1, color);
+    if (decimals != 0)
+    {
+        draw_glyph(x, y, ascii_font['.' - 32], color);
+        x = draw_digits(x + 8, y, magnitude % pow10[decimals], decimals, color);
+    }
+    return x - origin_x;
+}
 
-    while (y >= x)
+int16_t SSD1306_DrawTime(int16_t x, int16_t y, uint8_t hours, uint8_t minutes, uint8_t seconds, uint8_t color)
+{
+    x += origin_x;
+    y += origin_y;
+    x = draw_digits(x, y, hours, 2, color);
+    draw_glyph(x, y, ascii_font[':' - 32], color);
+    x = draw_digits(x + 8, y, minutes, 2, color);
+    draw_glyph(x, y, ascii_font[':' - 32], color);
+    return draw_digits(x + 8, y, seconds, 2, color) - origin_x;
+}
+
+// Quarter-wave sine table, one entry per degree (0-90), Q15
+static const int16_t sine_table[91] = {
+    0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126,
+    5690, 6252, 6813, 7371, 7927, 8481, 9032, 9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+    16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+    21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+    25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+    28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+    30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+    32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+    32767};
+
+int16_t SSD1306_Sin(int16_t angle)
+{
+    int16_t a = angle % SSD1306_ANGLE_FULL;
+    int16_t sign = 1;
+
+    if (a < 0)
+        a += SSD1306_ANGLE_FULL;
+    if (a >= SSD1306_ANGLE_FULL / 2)
+    {
+        a -= SSD1306_ANGLE_FULL / 2; // sin(a + 180) = -sin(a)
+        sign = -1;
+    }
+    if (a > SSD1306_ANGLE_FULL / 4)
+    {
+        a = SSD1306_ANGLE_FULL / 2 - a; // sin(180 - a) = sin(a)
+    }
+
+    // Linear interpolation between whole degrees
+    int16_t deg = a / 10;
+    int16_t frac = a % 10;
+    int16_t value = sine_table[deg];
+    if (frac != 0)
     {
-        // Fill corner areas with horizontal lines
-        SSD1306_DrawLine(cx1 - x, cy1 - y, cx1 + x, cy1 - y, color);
-        SSD1306_DrawLine(cx1 - x, cy2 + y, cx1 + x, cy2 + y, color);
-        SSD1306_DrawLine(cx2 - x, cy1 - y, cx2 + x, cy1 - y, color);
-        SSD1306_DrawLine(cx2 - x, cy2 + y, cx2 + x, cy2 + y, color);
+        value += (int16_t)(((int32_t)(sine_table[deg + 1] - value) * frac) / 10);
+    }
+    return sign * value;
+}
+
+int16_t SSD1306_Cos(int16_t angle)
+{
+    return SSD1306_Sin(angle + SSD1306_ANGLE_FULL / 4);
+}
+
+void SSD1306_PolarPoint(int16_t cx, int16_t cy, uint8_t radius, int16_t angle, int16_t *x, int16_t *y)
+{
+    // Angle 0 points up (12 o'clock) and grows clockwise; Q15 products are rounded to the nearest pixel
+    *x = cx + (int16_t)(((int32_t)radius * SSD1306_Sin(angle) + 16384) >> 15);
+    *y = cy - (int16_t)(((int32_t)radius * SSD1306_Cos(angle) + 16384) >> 15);
+}
+
+void SSD1306_DrawLinePolar(int16_t cx, int16_t cy, uint8_t r0, uint8_t r1, int16_t angle, uint8_t color)
+{
+    int16_t x0, y0, x1, y1;
 
-        if (y != x)
+    SSD1306_PolarPoint(cx, cy, r0, angle, &x0, &y0);
+    SSD1306_PolarPoint(cx, cy, r1, angle, &x1, &y1);
+    SSD1306_DrawLine(x0, y0, x1, y1, color);
+}
+
+void SSD1306_DrawTickRing(int16_t cx, int16_t cy, uint8_t r0, uint8_t r1, uint8_t count, uint8_t skip_every, uint8_t color)
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (skip_every != 0 && i % skip_every == 0)
         {
-            SSD1306_DrawLine(cx1 - y, cy1 - x, cx1 + y, cy1 - x, color);
-            SSD1306_DrawLine(cx1 - y, cy2 + x, cx1 + y, cy2 + x, color);
-            SSD1306_DrawLine(cx2 - y, cy1 - x, cx2 + y, cy1 - x, color);
-            SSD1306_DrawLine(cx2 - y, cy2 + x, cx2 + y, cy2 + x, color);
+            continue; // Position owned by a coarser ring
         }
 
-        if (d < 0)
+        int16_t angle = (int16_t)((int32_t)i * SSD1306_ANGLE_FULL / count);
+        if (r0 == r1)
         {
-            d += (x << 2) + 6;
-            x++;
+            int16_t x, y;
+            SSD1306_PolarPoint(cx, cy, r0, angle, &x, &y);
+            SSD1306_DrawPixel(x, y, color);
         }
         else
         {
-            d += ((x - y) << 2) + 10;
-            x++;
-            y--;
+            SSD1306_DrawLinePolar(cx, cy, r0, r1, angle, color);
         }
     }
 }
 
-// Helper function to lookup UTF-8 character
-static int find_utf8_char(const uint8_t *utf8_bytes)
+void SSD1306_DrawNeedle(int16_t cx, int16_t cy, uint8_t length, uint8_t width, int16_t angle, uint8_t color)
 {
-    for (int i = 0; i < sizeof(utf8_lookup) / sizeof(utf8_lookup[0]); i++)
+    int16_t tip_x, tip_y;
+
+    SSD1306_PolarPoint(cx, cy, length, angle, &tip_x, &tip_y);
+    if (width <= 1)
     {
-        if (utf8_lookup[i].utf8_bytes[0] == utf8_bytes[0] &&
-            utf8_lookup[i].utf8_bytes[1] == utf8_bytes[1] &&
-            (utf8_lookup[i].utf8_bytes[2] == 0 || utf8_lookup[i].utf8_bytes[2] == utf8_bytes[2]))
-        {
-            return utf8_lookup[i].font_index;
-        }
+        SSD1306_DrawLine(cx, cy, tip_x, tip_y, color);
+        return;
     }
-    return -1; // Not found
+
+    // Tapered needle: base perpendicular to the direction, half width on each side of the center
+    int16_t lx, ly, rx, ry;
+    SSD1306_PolarPoint(cx, cy, width >> 1, angle - SSD1306_ANGLE_FULL / 4, &lx, &ly);
+    SSD1306_PolarPoint(cx, cy, width >> 1, angle + SSD1306_ANGLE_FULL / 4, &rx, &ry);
+    int16_t spine[4] = {cx + origin_x, cy + origin_y, tip_x + origin_x, tip_y + origin_y};
+    fill_triangle(lx + origin_x, ly + origin_y, rx + origin_x, ry + origin_y, spine[2], spine[3], color, spine);
+    draw_line(spine[0], spine[1], spine[2], spine[3], color, 0); // Keep the spine solid where the triangle thins out
 }
 
-void SSD1306_DrawChar(uint8_t x, uint8_t y, char c, uint8_t color)
+// Angular range of an arc or sector, as two half-planes through the center
+typedef struct
 {
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    int16_t s0, c0; // Direction of the start angle (Q15)
+    int16_t s1, c1; // Direction of the end angle (Q15)
+    int16_t start;  // Start angle normalized to 0..SSD1306_ANGLE_FULL-1
+    int16_t sweep;  // Clockwise extent (SSD1306_ANGLE_FULL = full circle)
+} arc_range_t;
+
+// Normalize an angle to 0..SSD1306_ANGLE_FULL-1
+static int16_t normalize_angle(int16_t angle)
+{
+    angle %= SSD1306_ANGLE_FULL;
+    return (angle < 0) ? angle + SSD1306_ANGLE_FULL : angle;
+}
+
+static void arc_range_init(arc_range_t *range, int16_t start_angle, int16_t end_angle)
+{
+    int16_t start = normalize_angle(start_angle);
+
+    int32_t sweep = (int32_t)end_angle - start_angle;
+    if (sweep >= SSD1306_ANGLE_FULL || sweep <= -SSD1306_ANGLE_FULL)
     {
-        return; // Out of bounds
+        sweep = SSD1306_ANGLE_FULL;
     }
-
-    if (c < 32 || c > 126)
+    else
     {
-        return; // Unsupported character
+        sweep %= SSD1306_ANGLE_FULL;
+        if (sweep < 0)
+            sweep += SSD1306_ANGLE_FULL;
     }
 
-    const uint8_t *font = ascii_font[c - 32]; // Get the font data for the character
+    range->start = start;
+    range->sweep = (int16_t)sweep;
+    range->s0 = SSD1306_Sin(start);
+    range->c0 = SSD1306_Cos(start);
+    range->s1 = SSD1306_Sin(start + range->sweep);
+    range->c1 = SSD1306_Cos(start + range->sweep);
+}
 
-    for (uint8_t i = 0; i < 8; i++)
+// Point (dx, dy) relative to the center (y down) lies inside the angular range
+static uint8_t arc_contains(const arc_range_t *range, int16_t dx, int16_t dy)
+{
+    if (range->sweep >= SSD1306_ANGLE_FULL)
     {
-        for (uint8_t j = 0; j < 8; j++)
-        {
-            if (font[i] & (1 << j))
-            {
-                // Direct pixel drawing for performance
-                if (x + i < SSD1306_WIDTH && y + j < SSD1306_HEIGHT)
-                {
-                    if (color)
-                    {
-                        buffer[(x + i) + ((y + j) / 8) * SSD1306_WIDTH] |= (1 << ((y + j) % 8));
-                    }
-                    else
-                    {
-                        buffer[(x + i) + ((y + j) / 8) * SSD1306_WIDTH] &= ~(1 << ((y + j) % 8));
-                    }
-                }
-            }
-        }
+        return 1;
     }
+
+    int32_t after_start = (int32_t)range->s0 * dy + (int32_t)range->c0 * dx; // >= 0: clockwise of start
+    int32_t before_end = -(int32_t)range->c1 * dx - (int32_t)range->s1 * dy;  // >= 0: counterclockwise of end
+
+    if (range->sweep <= SSD1306_ANGLE_FULL / 2)
+        return after_start >= 0 && before_end >= 0;
+    return after_start >= 0 || before_end >= 0;
 }
 
-// Draw UTF-8 character (Greek letters, special symbols)
-void SSD1306_DrawCharUTF8(uint8_t x, uint8_t y, const uint8_t *utf8_bytes, uint8_t color)
+void SSD1306_DrawArc(int16_t x0, int16_t y0, uint8_t radius, int16_t start_angle, int16_t end_angle, uint8_t color)
 {
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    // Octant transforms of the midpoint circle point (x, y), x >= y, in clockwise order from 12 o'clock
+    static const int8_t octant_sign[8][4] = {
+        {0, 1, -1, 0}, {1, 0, 0, -1}, {1, 0, 0, 1}, {0, 1, 1, 0},
+        {0, -1, 1, 0}, {-1, 0, 0, 1}, {-1, 0, 0, -1}, {0, -1, -1, 0}};
+    // Octant sharing the point on an axis (y == 0) and on a diagonal (x == y)
+    static const uint8_t axis_partner[8] = {7, 2, 1, 4, 3, 6, 5, 0};
+    static const uint8_t diagonal_partner[8] = {1, 0, 3, 2, 5, 4, 7, 6};
+    arc_range_t range;
+    uint8_t octant_state[8]; // 0 = outside, 1 = partially covered, 2 = fully covered
+
+    x0 += origin_x;
+    y0 += origin_y;
+    plot_fn_t plot = select_plotter(x0 - radius, y0 - radius, x0 + radius, y0 + radius);
+
+    arc_range_init(&range, start_angle, end_angle);
+    if (range.sweep == 0 || plot == 0)
     {
-        return; // Out of bounds
+        return; // Empty arc or entirely outside the clip window
+    }
+    if (radius == 0)
+    {
+        plot(x0, y0, color); // Every octant is the center
+        return;
     }
 
-    int font_index = find_utf8_char(utf8_bytes);
-    if (font_index < 0)
+    for (uint8_t k = 0; k < 8; k++)
     {
-        return; // Character not found
+        int16_t octant_start = k * (SSD1306_ANGLE_FULL / 8);
+        int16_t offset = normalize_angle(octant_start - range.start); // Octant start, seen from the arc start
+
+        if (offset + SSD1306_ANGLE_FULL / 8 <= range.sweep)
+            octant_state[k] = 2;
+        else if (offset <= range.sweep || normalize_angle(range.start - octant_start) <= SSD1306_ANGLE_FULL / 8)
+            octant_state[k] = 1;
+        else
+            octant_state[k] = 0;
     }
 
-    const uint8_t *font = extended_font[font_index];
+    int x = radius;
+    int y = 0;
+    int err = 1 - radius;
 
-    for (uint8_t i = 0; i < 8; i++)
+    while (x >= y)
     {
-        for (uint8_t j = 0; j < 8; j++)
+        for (uint8_t k = 0; k < 8; k++)
         {
-            if (font[i] & (1 << j))
+            // A point two octants share is plotted once, from the lower one, if either covers it
+            uint8_t partner = (y == 0) ? axis_partner[k] : (x == y) ? diagonal_partner[k] : k;
+            uint8_t state = octant_state[k];
+            if (partner < k)
+                continue;
+            if (octant_state[partner] > state)
+                state = octant_state[partner];
+            if (state == 0)
+                continue;
+
+            const int8_t *m = octant_sign[k];
+            int16_t dx = m[0] * x + m[1] * y;
+            int16_t dy = m[2] * x + m[3] * y;
+
+            if (state == 2 || arc_contains(&range, dx, dy))
             {
-                // Direct pixel drawing for performance
-                if (x + i < SSD1306_WIDTH && y + j < SSD1306_HEIGHT)
-                {
-                    if (color)
-                    {
-                        buffer[(x + i) + ((y + j) / 8) * SSD1306_WIDTH] |= (1 << ((y + j) % 8));
-                    }
-                    else
-                    {
-                        buffer[(x + i) + ((y + j) / 8) * SSD1306_WIDTH] &= ~(1 << ((y + j) % 8));
-                    }
-                }
+                plot(x0 + dx, y0 + dy, color);
             }
         }
+
+        y++;
+        if (err < 0)
+        {
+            err += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            err += 2 * (y - x) + 1;
+        }
     }
 }
 
-void SSD1306_DrawString(uint8_t x, uint8_t y, const char *str, uint8_t color)
+// Floor and ceiling of a / b for b != 0
+static int32_t floor_div(int32_t a, int32_t b)
 {
-    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    int32_t q = a / b;
+    return (q * b != a && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+static int32_t ceil_div(int32_t a, int32_t b)
+{
+    int32_t q = a / b;
+    return (q * b != a && ((a < 0) == (b < 0))) ? q + 1 : q;
+}
+
+// Column interval [lo, hi] of dy satisfying s * dy + c * dx >= 0 (lo > hi = empty)
+static void half_plane_span(int16_t s, int16_t c, int16_t dx, int16_t *lo, int16_t *hi)
+{
+    int32_t k = -(int32_t)c * dx;
+
+    *lo = -SSD1306_HEIGHT * 2;
+    *hi = SSD1306_HEIGHT * 2;
+    if (s > 0)
     {
-        return; // Out of bounds
+        int32_t t = ceil_div(k, s);
+        if (t > *lo)
+            *lo = (t > *hi) ? *hi + 1 : (int16_t)t;
+    }
+    else if (s < 0)
+    {
+        int32_t t = floor_div(k, s);
+        if (t < *hi)
+            *hi = (t < *lo) ? *lo - 1 : (int16_t)t;
+    }
+    else if (k > 0)
+    {
+        *lo = 1; // Whole column outside
+        *hi = 0;
     }
+}
 
-    const uint8_t *utf8_str = (const uint8_t *)str;
+// Write the part of a ring column (|dy| <= outer_h and |dy| > hole) that lies inside [lo, hi]
+static void fill_ring_column(int16_t x, int16_t cy, int16_t outer_h, int16_t hole, int16_t lo, int16_t hi, uint8_t color)
+{
+    if (lo < -outer_h)
+        lo = -outer_h;
+    if (hi > outer_h)
+        hi = outer_h;
+    if (lo > hi)
+        return;
 
-    while (*utf8_str != 0) // Explicit check for null terminator
+    if (hole < 0 || hi < -hole || lo > hole)
     {
-        if (x >= SSD1306_WIDTH - 7) // Check for tight fit (8 pixels wide)
+        fill_vspan(x, cy + lo, cy + hi, color); // Span does not cross the hole
+        return;
+    }
+    if (lo < -hole)
+        fill_vspan(x, cy + lo, cy - hole - 1, color);
+    if (hi > hole)
+        fill_vspan(x, cy + hole + 1, cy + hi, color);
+}
+
+void SSD1306_FillAnnulusSector(int16_t x0, int16_t y0, uint8_t inner_radius, uint8_t outer_radius,
+                               int16_t start_angle, int16_t end_angle, uint8_t color)
+{
+    arc_range_t range;
+    int32_t outer_limit = (int32_t)outer_radius * outer_radius + outer_radius;
+    int32_t inner_limit = (int32_t)inner_radius * inner_radius - inner_radius;
+    int16_t outer_h = outer_radius;
+    int16_t inner_h = inner_radius;
+
+    x0 += origin_x;
+    y0 += origin_y;
+    color = fill_color(color);
+
+    arc_range_init(&range, start_angle, end_angle);
+    if (inner_radius > outer_radius || range.sweep == 0 ||
+        select_plotter(x0 - outer_radius, y0 - outer_radius, x0 + outer_radius, y0 + outer_radius) == 0)
+    {
+        return; // Empty ring, empty sweep or entirely outside the clip window
+    }
+
+    // Walk columns outward from the center so the half heights only ever shrink (midpoint style, no sqrt)
+    for (int16_t dx = 0; dx <= outer_radius; dx++)
+    {
+        int32_t dx2 = (int32_t)dx * dx;
+
+        while (outer_h >= 0 && dx2 + (int32_t)outer_h * outer_h > outer_limit)
+            outer_h--;
+        while (inner_h >= 0 && dx2 + (int32_t)inner_h * inner_h > inner_limit)
+            inner_h--;
+        if (outer_h < 0)
+            break;
+
+        int16_t hole = (inner_radius == 0) ? -1 : inner_h; // Half height of the excluded hole (-1 = none)
+
+        for (int8_t side = (dx == 0) ? 1 : -1; side <= 1; side += 2)
         {
-            x = 0; // Move to next line if out of bounds
-            y += 8;
-            if (y >= SSD1306_HEIGHT - 7) // Check for tight vertical fit
+            int16_t col_dx = side * dx;
+            int16_t x = x0 + col_dx;
+
+            if (x < clip_x0 || x >= clip_x1)
+                continue;
+
+            if (range.sweep >= SSD1306_ANGLE_FULL)
             {
-                break; // Stop if out of vertical bounds
+                fill_ring_column(x, y0, outer_h, hole, -outer_h, outer_h, color);
+                continue;
             }
-        }
-
-        // Check for UTF-8 multi-byte character
-        if (*utf8_str >= 0x80)
-        {
-            // Multi-byte UTF-8 character
-            uint8_t utf8_bytes[3] = {0};
-            int byte_count = 0;
 
-            // Determine number of bytes in UTF-8 character
-            if ((*utf8_str & 0xE0) == 0xC0)
-                byte_count = 2; // 110xxxxx
-            else if ((*utf8_str & 0xF0) == 0xE0)
-                byte_count = 3; // 1110xxxx
-            else
-                byte_count = 1; // Invalid, treat as single byte
+            int16_t a_lo, a_hi, b_lo, b_hi;
+            half_plane_span(range.s0, range.c0, col_dx, &a_lo, &a_hi);   // Clockwise of start
+            half_plane_span(-range.s1, -range.c1, col_dx, &b_lo, &b_hi); // Counterclockwise of end
 
-            // Copy UTF-8 bytes and ensure we don't go past string end
-            for (int i = 0; i < byte_count && i < 3 && utf8_str[i] != 0; i++)
+            if (range.sweep <= SSD1306_ANGLE_FULL / 2)
             {
-                utf8_bytes[i] = utf8_str[i];
+                // Narrow sector: intersection of the half-planes
+                fill_ring_column(x, y0, outer_h, hole, (a_lo > b_lo) ? a_lo : b_lo, (a_hi < b_hi) ? a_hi : b_hi, color);
+                continue;
             }
 
-            SSD1306_DrawCharUTF8(x, y, utf8_bytes, color);
-            utf8_str += byte_count;
-        }
-        else if (*utf8_str >= 32 && *utf8_str <= 126)
-        {
-            // Regular ASCII character (only printable characters)
-            SSD1306_DrawChar(x, y, *utf8_str, color);
-            utf8_str++;
-        }
-        else
-        {
-            // Skip invalid characters (including null terminator, control chars)
-            utf8_str++;
-            continue; // Don't advance x position for invalid characters
+            // Wide sector: union of the half-planes, merged so no pixel is written twice
+            if (a_lo > a_hi)
+            {
+                a_lo = b_lo; // First interval empty: keep only the second
+                a_hi = b_hi;
+                b_lo = 1;
+                b_hi = 0;
+            }
+            else if (b_lo <= b_hi)
+            {
+                if (a_lo > b_lo)
+                {
+                    int16_t t = a_lo;
+                    a_lo = b_lo;
+                    b_lo = t;
+                    t = a_hi;
+                    a_hi = b_hi;
+                    b_hi = t;
+                }
+                if (b_lo <= a_hi + 1)
+                {
+                    if (b_hi > a_hi)
+                        a_hi = b_hi;
+                    b_lo = 1; // Merged into the first interval
+                    b_hi = 0;
+                }
+            }
+            fill_ring_column(x, y0, outer_h, hole, a_lo, a_hi, color);
+            fill_ring_column(x, y0, outer_h, hole, b_lo, b_hi, color);
         }
-
-        x += 8; // Move to next character position (no gap)
     }
-}
\ No newline at end of file
+}
+
+void SSD1306_FillSector(int16_t x0, int16_t y0, uint8_t radius, int16_t start_angle, int16_t end_angle, uint8_t color)
+{
+    SSD1306_FillAnnulusSector(x0, y0, 0, radius, start_angle, end_angle, color);
+}
@@ -85,4 +85,106 @@ void SSD1306_IIC_HAL(uint8_t Mode, uint8_t *Command, uint8_t Length)
     //     ;
     I2C_GenerateSTOP(I2C1, ENABLE);
     // printf("I2C Stop\r\n");
-}
\ No newline at end of file
+}
+
+void SSD1306_IIC_Packet_HAL(uint8_t *Packet, uint16_t Length)
+{
+    while (I2C_GetFlagStatus(I2C1, I2C_FLAG_BUSY) != RESET)
+        ;
+    I2C_GenerateSTART(I2C1, ENABLE);
+    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_MODE_SELECT))
+        ;
+    I2C_Send7bitAddress(I2C1, SSD1306_ADDRESS << 1, I2C_Direction_Transmitter);
+    while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_TRANSMITTER_MODE_SELECTED))
+        ;
+    // The control byte is the first byte of the packet
+    for (uint16_t i = 0; i < Length; i++)
+    {
+        I2C_SendData(I2C1, Packet[i]);
+        while (!I2C_CheckEvent(I2C1, I2C_EVENT_MASTER_BYTE_TRANSMITTED))
+            ;
+    }
+    I2C_GenerateSTOP(I2C1, ENABLE);
+}
+
+// Blocking reference implementation: the packet is complete on return
+// For overlapped transfers start an I2C DMA transfer here, report it in SSD1306_IIC_Busy_HAL()
+// and call SSD1306_Poll() from the DMA transfer-complete interrupt
+void SSD1306_IIC_Packet_Start_HAL(uint8_t *Packet, uint16_t Length)
+{
+    SSD1306_IIC_Packet_HAL(Packet, Length);
+}
+
+uint8_t SSD1306_IIC_Busy_HAL(void)
+{
+    return 0;
+}
+
+// Every transfer above is complete on return, nothing is held back
+void SSD1306_IIC_Flush_HAL(void)
+{
+}
+
+void SSD1306_Flash_Init_HAL(void)
+{
+    GPIO_InitTypeDef GPIO_InitStructure = {0};
+    SPI_InitTypeDef SPI_InitStructure = {0};
+
+    RCC_APB2PeriphClockCmd(RCC_APB2Periph_GPIOA | RCC_APB2Periph_SPI1, ENABLE);
+
+    // A4-CS, A5-SCK, A6-MISO, A7-MOSI
+    GPIO_InitStructure.GPIO_Pin = SSD1306_FLASH_CS;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_Out_PP;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+    GPIO_SetBits(GPIOA, SSD1306_FLASH_CS);
+
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_5 | GPIO_Pin_7;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF_PP;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Speed_50MHz;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    GPIO_InitStructure.GPIO_Pin = GPIO_Pin_6;
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_IN_FLOATING;
+    GPIO_Init(GPIOA, &GPIO_InitStructure);
+
+    SPI_InitStructure.SPI_Direction = SPI_Direction_2Lines_FullDuplex;
+    SPI_InitStructure.SPI_Mode = SPI_Mode_Master;
+    SPI_InitStructure.SPI_DataSize = SPI_DataSize_8b;
+    SPI_InitStructure.SPI_CPOL = SPI_CPOL_High;
+    SPI_InitStructure.SPI_CPHA = SPI_CPHA_2Edge;
+    SPI_InitStructure.SPI_NSS = SPI_NSS_Soft;
+    SPI_InitStructure.SPI_BaudRatePrescaler = SPI_BaudRatePrescaler_4;
+    SPI_InitStructure.SPI_FirstBit = SPI_FirstBit_MSB;
+    SPI_InitStructure.SPI_CRCPolynomial = 7;
+    SPI_Init(SPI1, &SPI_InitStructure);
+
+    SPI_Cmd(SPI1, ENABLE);
+}
+
+static uint8_t SSD1306_Flash_Transfer(uint8_t data)
+{
+    while (SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_TXE) == RESET)
+        ;
+    SPI_I2S_SendData(SPI1, data);
+    while (SPI_I2S_GetFlagStatus(SPI1, SPI_I2S_FLAG_RXNE) == RESET)
+        ;
+    return SPI_I2S_ReceiveData(SPI1);
+}
+
+void SSD1306_Flash_Read_HAL(uint32_t address, uint8_t *data, uint16_t length)
+{
+    GPIO_ResetBits(GPIOA, SSD1306_FLASH_CS);
+
+    SSD1306_Flash_Transfer(0x03); // Read Data (25-series SPI NOR flash)
+    SSD1306_Flash_Transfer(address >> 16);
+    SSD1306_Flash_Transfer(address >> 8);
+    SSD1306_Flash_Transfer(address);
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        data[i] = SSD1306_Flash_Transfer(0xFF);
+    }
+
+    GPIO_SetBits(GPIOA, SSD1306_FLASH_CS);
+}
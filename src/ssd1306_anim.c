@@ -0,0 +1,86 @@
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_anim.h"
+
+// Decode count PackBits bytes from src into dst and return the position after them
+static const uint8_t *unpack_span(const uint8_t *src, uint8_t *dst, uint8_t count)
+{
+    while (count)
+    {
+        uint8_t control = *src++;
+        uint8_t length;
+
+        if (control == 0x80)
+            continue; // No-op
+        if (control < 0x80)
+        {
+            length = control + 1; // Literal bytes follow
+            if (length > count)
+                length = count;
+            for (uint8_t i = 0; i < length; i++)
+                dst[i] = src[i];
+            src += control + 1;
+        }
+        else
+        {
+            length = 257 - control; // Next byte repeated
+            if (length > count)
+                length = count;
+            for (uint8_t i = 0; i < length; i++)
+                dst[i] = *src;
+            src++;
+        }
+        dst += length;
+        count -= length;
+    }
+    return src;
+}
+
+void SSD1306_Anim_Start(SSD1306_AnimPlayer *player, const SSD1306_Animation *anim)
+{
+    player->anim = anim;
+    player->offset = 0;
+    player->frame = 0;
+}
+
+uint8_t SSD1306_Anim_NextFrame(SSD1306_AnimPlayer *player, int16_t x, int16_t y)
+{
+    const SSD1306_Animation *anim = player->anim;
+    uint8_t strip[SSD1306_WIDTH];
+
+    if (player->frame >= anim->frame_count)
+    {
+        if (anim->loop_offset == 0)
+        {
+            return 0; // End of a one-shot animation
+        }
+        // The last frame of a looping stream brings the picture back to frame 0
+        player->offset = anim->loop_offset;
+        player->frame = 1;
+    }
+
+    const uint8_t *src = &anim->data[player->offset];
+    uint8_t page_mask = *src++;
+    uint8_t mode = (*src++ & SSD1306_ANIM_FRAME_KEY) ? SSD1306_BLIT_OPAQUE : SSD1306_BLIT_XOR;
+
+    for (uint8_t page = 0; page_mask; page++, page_mask >>= 1)
+    {
+        if (!(page_mask & 1))
+            continue;
+
+        uint8_t start_col = *src++;
+        uint8_t width = *src++ - start_col + 1;
+        uint8_t rows = anim->height - page * 8;
+        if (rows > 8)
+            rows = 8;
+
+        src = unpack_span(src, strip, width);
+        SSD1306_DrawBitmapEx(x + start_col, y + page * 8, strip, width, rows, SSD1306_BITMAP_PAGE_MAJOR, mode);
+        SSD1306_Invalidate(x + start_col, y + page * 8, width, rows);
+    }
+
+    player->offset = src - anim->data;
+    player->frame++;
+    return 1;
+}
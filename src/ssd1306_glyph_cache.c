@@ -0,0 +1,227 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_glyph_cache.h"
+
+typedef struct
+{
+    uint32_t last_used;      // LRU timestamp (0 = empty slot)
+    SSD1306_FontGlyph glyph; // width == 0 marks a cached miss
+    uint8_t bitmap[SSD1306_GLYPH_CACHE_MAX_BYTES];
+} glyph_slot_t;
+
+static glyph_slot_t slots[SSD1306_GLYPH_CACHE_SLOTS];
+static uint32_t use_counter = 0;
+
+static SSD1306_GlyphRead storage_read = 0;
+static SSD1306_GlyphClock storage_clock = 0;
+static uint32_t image_base = 0;
+static uint16_t image_glyph_count = 0;
+
+// Font metrics of the external image; bitmaps/glyphs are pointed at a slot when drawing
+static SSD1306_Font image_font;
+
+static SSD1306_GlyphCacheStats cache_stats;
+
+static uint16_t read_u16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+uint8_t SSD1306_GlyphCache_Init(SSD1306_GlyphRead read, uint32_t base_address, SSD1306_GlyphClock clock)
+{
+    uint8_t header[SSD1306_GLYPH_IMAGE_HEADER_SIZE];
+
+    storage_read = read;
+    storage_clock = clock;
+    image_base = base_address;
+    image_glyph_count = 0;
+
+    SSD1306_GlyphCache_Flush();
+    SSD1306_GlyphCache_ResetStats();
+
+    storage_read(image_base, header, sizeof(header));
+    if (header[0] != 'S' || header[1] != 'G' || header[2] != 'F' || header[3] != '1')
+    {
+        return 0; // Not a glyph image
+    }
+
+    image_glyph_count = read_u16(&header[4]);
+    image_font.height = header[6];
+    image_font.baseline = header[7];
+    image_font.line_height = header[8];
+    image_font.default_advance = header[9];
+    image_font.glyph_count = 1;
+    return 1;
+}
+
+// Binary search of the code point index in storage, filling the slot on success
+static uint8_t fetch_glyph(uint32_t codepoint, glyph_slot_t *slot)
+{
+    uint8_t entry[SSD1306_GLYPH_IMAGE_ENTRY_SIZE];
+    int lo = 0;
+    int hi = (int)image_glyph_count - 1;
+
+    while (lo <= hi)
+    {
+        int mid = (lo + hi) >> 1;
+
+        storage_read(image_base + SSD1306_GLYPH_IMAGE_HEADER_SIZE + (uint32_t)mid * SSD1306_GLYPH_IMAGE_ENTRY_SIZE,
+                     entry, sizeof(entry));
+        cache_stats.storage_reads++;
+
+        uint16_t cp = read_u16(&entry[0]);
+        if (cp == codepoint)
+        {
+            uint16_t size = entry[2] * ((image_font.height + 7) >> 3);
+            if (size > SSD1306_GLYPH_CACHE_MAX_BYTES)
+            {
+                return 0; // Glyph does not fit a cache slot
+            }
+
+            slot->glyph.width = entry[2];
+            slot->glyph.advance = entry[3];
+            storage_read(image_base + read_u32(&entry[4]), slot->bitmap, size);
+            cache_stats.storage_reads++;
+            return 1;
+        }
+        if (cp < codepoint)
+            lo = mid + 1;
+        else
+            hi = mid - 1;
+    }
+    return 0; // Not found
+}
+
+static glyph_slot_t *lookup_glyph(uint32_t codepoint)
+{
+    glyph_slot_t *victim = &slots[0];
+
+    if (codepoint > 0xFFFF)
+    {
+        codepoint = SSD1306_UTF8_REPLACEMENT; // The image index only covers the BMP
+    }
+
+    for (uint8_t i = 0; i < SSD1306_GLYPH_CACHE_SLOTS; i++)
+    {
+        glyph_slot_t *slot = &slots[i];
+        if (slot->last_used != 0 && slot->glyph.codepoint == codepoint)
+        {
+            slot->last_used = ++use_counter;
+            cache_stats.hits++;
+            return slot;
+        }
+        if (slot->last_used < victim->last_used)
+        {
+            victim = slot; // Least recently used (or empty) slot
+        }
+    }
+
+    cache_stats.misses++;
+    uint32_t start = storage_clock ? storage_clock() : 0;
+
+    victim->glyph.codepoint = (uint16_t)codepoint;
+    victim->glyph.offset = 0;
+    if (!fetch_glyph(codepoint, victim))
+    {
+        // Cache the miss too, so unknown characters do not hit storage every frame
+        victim->glyph.width = 0;
+        victim->glyph.advance = image_font.default_advance;
+    }
+    victim->last_used = ++use_counter;
+
+    if (storage_clock)
+    {
+        uint32_t elapsed = storage_clock() - start;
+        cache_stats.fetch_ticks_total += elapsed;
+        if (elapsed > cache_stats.fetch_ticks_max)
+            cache_stats.fetch_ticks_max = elapsed;
+    }
+    return victim;
+}
+
+static uint8_t draw_slot(int16_t x, int16_t y, glyph_slot_t *slot, uint8_t color)
+{
+    if (slot->glyph.width == 0)
+    {
+        return slot->glyph.advance; // Missing glyphs leave a blank gap
+    }
+
+    // Present the slot as a single-glyph font to reuse the page-major glyph renderer
+    image_font.bitmaps = slot->bitmap;
+    image_font.glyphs = &slot->glyph;
+    return SSD1306_DrawCharFont(x, y, &image_font, slot->glyph.codepoint, color);
+}
+
+uint8_t SSD1306_DrawCharCached(int16_t x, int16_t y, uint32_t codepoint, uint8_t color)
+{
+    if (image_glyph_count == 0)
+    {
+        return 0; // No glyph image
+    }
+
+    return draw_slot(x, y, lookup_glyph(codepoint), color);
+}
+
+void SSD1306_DrawStringCached(int16_t x, int16_t y, const char *str, uint8_t color)
+{
+    int16_t origin_x, origin_y;
+
+    // Bounds and line wrap in screen coordinates, as in SSD1306_DrawStringFont(); draw_slot() adds the origin again
+    SSD1306_GetOrigin(&origin_x, &origin_y);
+    x += origin_x;
+    y += origin_y;
+    if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT || image_glyph_count == 0)
+    {
+        return; // Out of bounds
+    }
+
+    const uint8_t *utf8_str = (const uint8_t *)str;
+
+    while (*utf8_str != 0)
+    {
+        uint32_t codepoint = SSD1306_DecodeUTF8(&utf8_str);
+
+        if (codepoint < 32 || codepoint == 127)
+        {
+            continue; // Don't advance x position for control characters
+        }
+
+        glyph_slot_t *slot = lookup_glyph(codepoint);
+        uint8_t width = slot->glyph.width ? slot->glyph.width : slot->glyph.advance;
+
+        if (x + width > SSD1306_WIDTH) // Glyph does not fit on this line
+        {
+            x = origin_x;
+            y += image_font.line_height;
+            if (y + image_font.height > SSD1306_HEIGHT)
+            {
+                break; // Stop if out of vertical bounds
+            }
+        }
+
+        x += draw_slot(x - origin_x, y - origin_y, slot, color);
+    }
+}
+
+void SSD1306_GlyphCache_GetStats(SSD1306_GlyphCacheStats *stats)
+{
+    *stats = cache_stats;
+}
+
+void SSD1306_GlyphCache_ResetStats(void)
+{
+    memset(&cache_stats, 0, sizeof(cache_stats));
+}
+
+void SSD1306_GlyphCache_Flush(void)
+{
+    memset(slots, 0, sizeof(slots));
+    use_counter = 0;
+}
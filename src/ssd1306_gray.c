@@ -0,0 +1,184 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_gray.h"
+
+typedef struct
+{
+    uint8_t plane;    // 0 = low bit plane, 1 = high bit plane
+    uint8_t contrast; // Contrast as a fraction of the base contrast (/2 steps: 0 = full, 1 = half)
+} gray_slot_t;
+
+// Slot tables: the high plane weighs twice the low plane, either by time or by contrast
+static const gray_slot_t time_slots[] = {{1, 0}, {1, 0}, {0, 0}};
+static const gray_slot_t contrast_slots[] = {{1, 0}, {0, 1}};
+
+static uint8_t *gray_planes = 0;
+static const gray_slot_t *slots = time_slots;
+static uint8_t slot_count = 3;
+static uint8_t slot_index = 0;
+static uint8_t base_contrast = 0x8F;
+static uint8_t shown_contrast = 0x8F;
+
+void SSD1306_Gray_Init(uint8_t *planes, uint8_t mode, uint8_t contrast)
+{
+    gray_planes = planes;
+    memset(gray_planes, 0, SSD1306_GRAY_BUFFER_SIZE);
+
+    if (mode == SSD1306_GRAY_MODE_CONTRAST)
+    {
+        slots = contrast_slots;
+        slot_count = sizeof(contrast_slots) / sizeof(contrast_slots[0]);
+    }
+    else
+    {
+        slots = time_slots;
+        slot_count = sizeof(time_slots) / sizeof(time_slots[0]);
+    }
+    slot_index = 0;
+    base_contrast = contrast;
+    shown_contrast = contrast;
+    SSD1306_SetContrast(contrast);
+}
+
+void SSD1306_Gray_Stop(void)
+{
+    if (shown_contrast != base_contrast)
+    {
+        SSD1306_SetContrast(base_contrast);
+        shown_contrast = base_contrast;
+    }
+    gray_planes = 0;
+}
+
+void SSD1306_Gray_Clear(uint8_t level)
+{
+    memset(gray_planes, (level & 1) ? 0xFF : 0x00, SSD1306_BUFFER_SIZE);
+    memset(gray_planes + SSD1306_BUFFER_SIZE, (level & 2) ? 0xFF : 0x00, SSD1306_BUFFER_SIZE);
+}
+
+// Write the rows in mask of one byte in both planes to level
+static void write_level(uint16_t index, uint8_t mask, uint8_t level)
+{
+    uint8_t *low = &gray_planes[index];
+    uint8_t *high = &gray_planes[SSD1306_BUFFER_SIZE + index];
+
+    *low = (level & 1) ? (uint8_t)(*low | mask) : (uint8_t)(*low & ~mask);
+    *high = (level & 2) ? (uint8_t)(*high | mask) : (uint8_t)(*high & ~mask);
+}
+
+void SSD1306_Gray_DrawPixel(int16_t x, int16_t y, uint8_t level)
+{
+    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT)
+    {
+        return; // Out of bounds
+    }
+    write_level(x + (y >> 3) * SSD1306_WIDTH, (uint8_t)(1 << (y & 7)), level);
+}
+
+void SSD1306_Gray_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t level)
+{
+    int16_t x1 = x + width - 1;
+    int16_t y1 = y + height - 1;
+
+    if (x < 0)
+        x = 0;
+    if (y < 0)
+        y = 0;
+    if (x1 >= SSD1306_WIDTH)
+        x1 = SSD1306_WIDTH - 1;
+    if (y1 >= SSD1306_HEIGHT)
+        y1 = SSD1306_HEIGHT - 1;
+    if (width == 0 || height == 0 || x > x1 || y > y1)
+    {
+        return; // Empty or off the screen
+    }
+
+    uint8_t first_page = y >> 3;
+    uint8_t last_page = y1 >> 3;
+
+    for (uint8_t page = first_page; page <= last_page; page++)
+    {
+        uint8_t mask = 0xFF;
+        if (page == first_page)
+            mask &= (uint8_t)(0xFF << (y & 7));
+        if (page == last_page)
+            mask &= (uint8_t)(0xFF >> (7 - (y1 & 7)));
+
+        for (int16_t col = x; col <= x1; col++)
+            write_level(page * SSD1306_WIDTH + col, mask, level);
+    }
+}
+
+// Opaque page-major blit of one plane (same shifting scheme as the mono blitter)
+static void blit_plane(uint8_t *plane, int16_t x, int16_t y, const uint8_t *src, uint8_t width, uint8_t height)
+{
+    int16_t x_start = (x > 0) ? x : 0;
+    int16_t x_end = (x + width < SSD1306_WIDTH) ? x + width : SSD1306_WIDTH;
+
+    if (x_start >= x_end || y >= SSD1306_HEIGHT || y + height <= 0 || height == 0)
+    {
+        return; // Off the screen
+    }
+
+    uint8_t shift = y & 7;
+    int16_t dst_page = (y - shift) / 8; // Floor, also for negative y
+    uint8_t src_pages = (height + 7) >> 3;
+
+    src += x_start - x;
+
+    for (uint8_t p = 0; p < src_pages; p++, src += width)
+    {
+        uint8_t mask = (p == src_pages - 1 && (height & 7)) ? (uint8_t)(0xFF >> (8 - (height & 7))) : 0xFF;
+        int16_t page = dst_page + p;
+
+        for (int16_t col = x_start; col < x_end; col++)
+        {
+            uint8_t bits = src[col - x_start] & mask;
+
+            if (page >= 0 && page < SSD1306_HEIGHT / 8)
+            {
+                uint8_t *dst = &plane[page * SSD1306_WIDTH + col];
+                uint8_t cover = (uint8_t)(mask << shift);
+                *dst = (uint8_t)((*dst & ~cover) | (bits << shift));
+            }
+            if (shift && page + 1 >= 0 && page + 1 < SSD1306_HEIGHT / 8)
+            {
+                uint8_t *dst = &plane[(page + 1) * SSD1306_WIDTH + col];
+                uint8_t cover = (uint8_t)(mask >> (8 - shift));
+                *dst = (uint8_t)((*dst & ~cover) | (bits >> (8 - shift)));
+            }
+        }
+    }
+}
+
+void SSD1306_Gray_DrawBitmap(int16_t x, int16_t y, const uint8_t *bitmap, uint8_t width, uint8_t height)
+{
+    uint16_t plane_size = width * ((height + 7) / 8);
+
+    blit_plane(gray_planes, x, y, bitmap, width, height);
+    blit_plane(gray_planes + SSD1306_BUFFER_SIZE, x, y, bitmap + plane_size, width, height);
+}
+
+uint8_t SSD1306_Gray_Tick(void)
+{
+    uint8_t shown = slot_index;
+    const gray_slot_t *slot = &slots[slot_index];
+    uint8_t contrast = base_contrast >> slot->contrast;
+
+    // The contrast is queued first so it goes out with this plane's first window command
+    if (contrast != shown_contrast)
+    {
+        SSD1306_SetContrast(contrast);
+        shown_contrast = contrast;
+    }
+    // Only the columns where this plane differs from the previous slot's plane go over the bus
+    SSD1306_UpdateFrom(gray_planes + slot->plane * SSD1306_BUFFER_SIZE);
+
+    if (++slot_index >= slot_count)
+    {
+        slot_index = 0;
+    }
+    return shown;
+}
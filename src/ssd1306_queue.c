@@ -0,0 +1,234 @@
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_queue.h"
+
+#if (SSD1306_QUEUE_SIZE & (SSD1306_QUEUE_SIZE - 1)) != 0 || SSD1306_QUEUE_SIZE > 128
+#error "SSD1306_QUEUE_SIZE must be a power of two up to 128"
+#endif
+
+// Keeps the compiler from moving ring accesses across the index updates (single core: no hardware fence needed)
+#define QUEUE_BARRIER() __asm__ volatile("" ::: "memory")
+
+// Draw command operations
+#define OP_PIXEL 0
+#define OP_LINE 1
+#define OP_RECT 2
+#define OP_FILL_RECT 3
+#define OP_CIRCLE 4
+#define OP_FILL_CIRCLE 5
+#define OP_INT 6
+
+// One queued draw call (12 bytes)
+typedef struct
+{
+    uint8_t op;
+    uint8_t color;
+    uint8_t arg0; // Width, radius or minimum digits
+    uint8_t arg1; // Height or field width
+    int16_t x;
+    int16_t y;
+    union
+    {
+        struct
+        {
+            int16_t x1; // Line end
+            int16_t y1;
+        } end;
+        int32_t value; // Integer to draw
+    } u;
+} draw_command_t;
+
+static draw_command_t ring[SSD1306_QUEUE_SIZE];
+
+// Free-running indices: head is written only by the producer, tail only by SSD1306_Queue_Drain()
+static volatile uint8_t queue_head = 0;
+static volatile uint8_t queue_tail = 0;
+static volatile uint16_t dropped = 0; // Written only by the producer
+
+// Claim the next free slot, or count the command as dropped and return NULL
+static draw_command_t *claim(uint8_t op, uint8_t color, int16_t x, int16_t y)
+{
+    uint8_t head = queue_head;
+
+    if ((uint8_t)(head - queue_tail) >= SSD1306_QUEUE_SIZE)
+    {
+        dropped++;
+        return 0;
+    }
+
+    draw_command_t *cmd = &ring[head & (SSD1306_QUEUE_SIZE - 1)];
+    cmd->op = op;
+    cmd->color = color;
+    cmd->x = x;
+    cmd->y = y;
+    return cmd;
+}
+
+// Hand the claimed slot to the consumer once the command is complete
+static uint8_t publish(void)
+{
+    QUEUE_BARRIER();
+    queue_head = queue_head + 1;
+    return 1;
+}
+
+uint8_t SSD1306_Queue_Pixel(int16_t x, int16_t y, uint8_t color)
+{
+    return claim(OP_PIXEL, color, x, y) ? publish() : 0;
+}
+
+uint8_t SSD1306_Queue_Line(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_LINE, color, x0, y0);
+
+    if (!cmd)
+        return 0;
+    cmd->u.end.x1 = x1;
+    cmd->u.end.y1 = y1;
+    return publish();
+}
+
+uint8_t SSD1306_Queue_Rect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_RECT, color, x, y);
+
+    if (!cmd)
+        return 0;
+    cmd->arg0 = width;
+    cmd->arg1 = height;
+    return publish();
+}
+
+uint8_t SSD1306_Queue_FillRect(int16_t x, int16_t y, uint8_t width, uint8_t height, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_FILL_RECT, color, x, y);
+
+    if (!cmd)
+        return 0;
+    cmd->arg0 = width;
+    cmd->arg1 = height;
+    return publish();
+}
+
+uint8_t SSD1306_Queue_Circle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_CIRCLE, color, x0, y0);
+
+    if (!cmd)
+        return 0;
+    cmd->arg0 = radius;
+    return publish();
+}
+
+uint8_t SSD1306_Queue_FillCircle(int16_t x0, int16_t y0, uint8_t radius, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_FILL_CIRCLE, color, x0, y0);
+
+    if (!cmd)
+        return 0;
+    cmd->arg0 = radius;
+    return publish();
+}
+
+uint8_t SSD1306_Queue_Int(int16_t x, int16_t y, int32_t value, uint8_t min_digits, uint8_t field_width, uint8_t color)
+{
+    draw_command_t *cmd = claim(OP_INT, color, x, y);
+
+    if (!cmd)
+        return 0;
+    cmd->arg0 = min_digits;
+    cmd->arg1 = field_width;
+    cmd->u.value = value;
+    return publish();
+}
+
+// Register the box between two inclusive corners (draw coordinates), in pieces SSD1306_Invalidate() can take
+static void invalidate_box(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    for (int32_t x = x0; x <= x1; x += 255)
+    {
+        for (int32_t y = y0; y <= y1; y += 255)
+        {
+            SSD1306_Invalidate((int16_t)x, (int16_t)y, (x1 - x >= 255) ? 255 : (uint8_t)(x1 - x + 1),
+                               (y1 - y >= 255) ? 255 : (uint8_t)(y1 - y + 1));
+        }
+    }
+}
+
+static void execute(const draw_command_t *cmd)
+{
+    int16_t x = cmd->x;
+    int16_t y = cmd->y;
+
+    switch (cmd->op)
+    {
+    case OP_PIXEL:
+        SSD1306_DrawPixel(x, y, cmd->color);
+        SSD1306_Invalidate(x, y, 1, 1);
+        break;
+    case OP_LINE:
+    {
+        int16_t x1 = cmd->u.end.x1;
+        int16_t y1 = cmd->u.end.y1;
+
+        SSD1306_DrawLine(x, y, x1, y1, cmd->color);
+        invalidate_box(x < x1 ? x : x1, y < y1 ? y : y1, x < x1 ? x1 : x, y < y1 ? y1 : y);
+        break;
+    }
+    case OP_RECT:
+    case OP_FILL_RECT:
+        if (cmd->op == OP_RECT)
+            SSD1306_DrawRect(x, y, cmd->arg0, cmd->arg1, cmd->color);
+        else
+            SSD1306_FillRect(x, y, cmd->arg0, cmd->arg1, cmd->color);
+        SSD1306_Invalidate(x, y, cmd->arg0, cmd->arg1);
+        break;
+    case OP_CIRCLE:
+    case OP_FILL_CIRCLE:
+        if (cmd->op == OP_CIRCLE)
+            SSD1306_DrawCircle(x, y, cmd->arg0, cmd->color);
+        else
+            SSD1306_FillCircle(x, y, cmd->arg0, cmd->color);
+        invalidate_box((int32_t)x - cmd->arg0, (int32_t)y - cmd->arg0, (int32_t)x + cmd->arg0, (int32_t)y + cmd->arg0);
+        break;
+    case OP_INT:
+    {
+        if (cmd->arg1 && cmd->color != SSD1306_COLOR_INVERT)
+        {
+            SSD1306_FillRect(x, y, cmd->arg1, 8, !cmd->color); // Clear the field with the background
+        }
+        int16_t end_x = SSD1306_DrawInt(x, y, cmd->u.value, cmd->arg0, cmd->color);
+        if (end_x < x + cmd->arg1)
+            end_x = x + cmd->arg1;
+        invalidate_box(x, y, (int32_t)end_x - 1, (int32_t)y + 7);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+uint8_t SSD1306_Queue_Drain(void)
+{
+    uint8_t tail = queue_tail;
+    uint8_t head = queue_head; // Commands posted from here on wait for the next drain
+    uint8_t count = head - tail;
+
+    QUEUE_BARRIER(); // Read the slots only after seeing head
+    while (tail != head)
+    {
+        draw_command_t cmd = ring[tail & (SSD1306_QUEUE_SIZE - 1)];
+
+        // Free the slot before the (slow) drawing so the producer can reuse it
+        QUEUE_BARRIER();
+        queue_tail = ++tail;
+        execute(&cmd);
+    }
+    return count;
+}
+
+uint16_t SSD1306_Queue_Dropped(void)
+{
+    return dropped;
+}
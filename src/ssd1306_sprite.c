@@ -0,0 +1,162 @@
+#include <string.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_sprite.h"
+
+static SSD1306_Sprite *sprites[SSD1306_SPRITE_MAX];
+static uint8_t sprite_count = 0;
+
+// Remove a sprite from the buffer: put back the saved background or toggle the image off again
+static void erase_sprite(SSD1306_Sprite *sprite)
+{
+    if (sprite->mode == SSD1306_SPRITE_XOR)
+    {
+        SSD1306_DrawBitmapEx(sprite->drawn_x, sprite->drawn_y, sprite->image, sprite->width, sprite->height,
+                             SSD1306_BITMAP_PAGE_MAJOR, SSD1306_BLIT_XOR);
+    }
+    else
+    {
+        SSD1306_DrawBitmapEx(sprite->drawn_x, sprite->drawn_y, sprite->save, sprite->width, sprite->height,
+                             SSD1306_BITMAP_PAGE_MAJOR, SSD1306_BLIT_OPAQUE);
+    }
+    sprite->on_buffer = 0;
+}
+
+static void draw_sprite(SSD1306_Sprite *sprite)
+{
+    if (sprite->mode == SSD1306_SPRITE_XOR)
+    {
+        SSD1306_DrawBitmapEx(sprite->x, sprite->y, sprite->image, sprite->width, sprite->height,
+                             SSD1306_BITMAP_PAGE_MAJOR, SSD1306_BLIT_XOR);
+    }
+    else
+    {
+        SSD1306_ReadBitmap(sprite->x, sprite->y, sprite->save, sprite->width, sprite->height);
+        if (sprite->mask)
+        {
+            SSD1306_DrawBitmapEx(sprite->x, sprite->y, sprite->mask, sprite->width, sprite->height,
+                                 SSD1306_BITMAP_PAGE_MAJOR, SSD1306_BLIT_CLEAR);
+        }
+        SSD1306_DrawBitmapEx(sprite->x, sprite->y, sprite->image, sprite->width, sprite->height,
+                             SSD1306_BITMAP_PAGE_MAJOR, SSD1306_BLIT_SET);
+    }
+    sprite->drawn_x = sprite->x;
+    sprite->drawn_y = sprite->y;
+    sprite->on_buffer = 1;
+}
+
+void SSD1306_Sprite_Init(SSD1306_Sprite *sprite, const uint8_t *image, const uint8_t *mask, uint8_t *save,
+                         uint8_t width, uint8_t height, uint8_t mode)
+{
+    memset(sprite, 0, sizeof(*sprite));
+    sprite->image = image;
+    sprite->mask = mask;
+    sprite->save = save;
+    sprite->width = width;
+    sprite->height = height;
+    sprite->mode = (save == 0) ? SSD1306_SPRITE_XOR : mode; // Save-under is impossible without a buffer
+}
+
+uint8_t SSD1306_Sprite_Register(SSD1306_Sprite *sprite)
+{
+    if (sprite_count >= SSD1306_SPRITE_MAX)
+    {
+        return 0; // Registry full
+    }
+
+    sprites[sprite_count++] = sprite;
+    sprite->changed = 1;
+    return 1;
+}
+
+void SSD1306_Sprite_Unregister(SSD1306_Sprite *sprite)
+{
+    for (uint8_t i = 0; i < sprite_count; i++)
+    {
+        if (sprites[i] != sprite)
+            continue;
+
+        // Lift every sprite so the backgrounds come back in the right order; the rest are redrawn on End
+        SSD1306_Sprite_Begin();
+        if (sprite->drawn)
+        {
+            SSD1306_Invalidate(sprite->drawn_x, sprite->drawn_y, sprite->width, sprite->height);
+            sprite->drawn = 0;
+        }
+
+        sprite_count--;
+        memmove(&sprites[i], &sprites[i + 1], (sprite_count - i) * sizeof(sprites[0]));
+        return;
+    }
+}
+
+void SSD1306_Sprite_MoveTo(SSD1306_Sprite *sprite, int16_t x, int16_t y)
+{
+    if (sprite->x != x || sprite->y != y)
+    {
+        sprite->x = x;
+        sprite->y = y;
+        sprite->changed = 1;
+    }
+}
+
+void SSD1306_Sprite_Show(SSD1306_Sprite *sprite, uint8_t visible)
+{
+    visible = visible ? 1 : 0;
+    if (sprite->visible != visible)
+    {
+        sprite->visible = visible;
+        sprite->changed = 1;
+    }
+}
+
+void SSD1306_Sprite_SetImage(SSD1306_Sprite *sprite, const uint8_t *image, const uint8_t *mask)
+{
+    if (sprite->on_buffer && sprite->mode == SSD1306_SPRITE_XOR)
+    {
+        SSD1306_Sprite_Begin(); // The old image is needed to toggle the sprite off
+    }
+
+    sprite->image = image;
+    sprite->mask = mask;
+    sprite->changed = 1;
+}
+
+void SSD1306_Sprite_Begin(void)
+{
+    // Erase in reverse drawing order so overlapping save-unders restore correctly
+    for (uint8_t i = sprite_count; i > 0; i--)
+    {
+        if (sprites[i - 1]->on_buffer)
+        {
+            erase_sprite(sprites[i - 1]);
+        }
+    }
+}
+
+void SSD1306_Sprite_End(void)
+{
+    SSD1306_Sprite_Begin(); // No-op when Begin was already called this frame
+
+    for (uint8_t i = 0; i < sprite_count; i++)
+    {
+        SSD1306_Sprite *sprite = sprites[i];
+
+        if (sprite->changed)
+        {
+            // Only the old and new bounding boxes can differ from the previous frame
+            if (sprite->drawn)
+                SSD1306_Invalidate(sprite->drawn_x, sprite->drawn_y, sprite->width, sprite->height);
+            if (sprite->visible)
+                SSD1306_Invalidate(sprite->x, sprite->y, sprite->width, sprite->height);
+            sprite->changed = 0;
+        }
+
+        if (sprite->visible)
+        {
+            draw_sprite(sprite);
+        }
+        sprite->drawn = sprite->visible;
+    }
+}
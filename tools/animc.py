@@ -0,0 +1,203 @@
+#!/usr/bin/env python3
+"""SSD1306 animation encoder.
+
+Converts a sequence of PNG/PGM frames (or one image holding the frames stacked
+vertically) into the delta frame stream played by SSD1306_Anim_NextFrame().
+The first frame is a key frame; every following frame stores, for each page
+that changed, the column span where it differs from the previous frame as a
+PackBits coded XOR delta. With --loop a last frame that leads back to frame 0
+is appended, so the player loops without a second key frame.
+
+Frames are converted and delta coded in parallel on all cores (-j).
+
+Usage:
+    python3 tools/animc.py frames/*.png --fps 25 --loop -o include/anim_boot.h
+    python3 tools/animc.py spinner.pgm --sheet 32 -d threshold --loop -o include/anim_spinner.h
+    python3 tools/animc.py clip/*.pgm -b clip.ssda        # binary stream for port/linux/anim_bench.c
+
+Only the Python 3 standard library is required. Image decoding and dithering are
+shared with tools/imgc.py.
+"""
+
+import argparse
+import multiprocessing
+import os
+import struct
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import imgc  # noqa: E402
+
+FRAME_KEY = 0x01
+BINARY_MAGIC = b"SSDA"
+
+
+def load(path, background):
+    if path.lower().endswith(".png"):
+        return imgc.read_png(path, background)
+    return imgc.read_pgm(path)
+
+
+def convert_frame(job):
+    """Dither one frame of luminance rows and return its page-major bytes."""
+    width, height, pixels, args = job
+    if args.invert:
+        pixels = [[255 - v for v in row] for row in pixels]
+    bits = imgc.dither(pixels, width, height, args.dither, args.threshold)
+    return bytes(imgc.to_page_major(width, height, bits))
+
+
+def encode_frame(job):
+    """Encode cur as a key frame (prev is None) or as the XOR delta from prev."""
+    prev, cur, width, pages = job
+    page_mask = 0
+    body = bytearray()
+    for page in range(pages):
+        row = cur[page * width:(page + 1) * width]
+        if prev is None:
+            start, end = 0, width - 1
+            span = row
+        else:
+            old = prev[page * width:(page + 1) * width]
+            delta = bytes(a ^ b for a, b in zip(old, row))
+            changed = [i for i, d in enumerate(delta) if d]
+            if not changed:
+                continue
+            start, end = changed[0], changed[-1]
+            span = delta[start:end + 1]
+        page_mask |= 1 << page
+        body += bytes((start, end))
+        body += imgc.packbits(span)
+    return bytes((page_mask, FRAME_KEY if prev is None else 0)) + bytes(body)
+
+
+def decode_frame(data, offset, frame, width, pages):
+    """Apply one encoded frame to frame (bytearray) and return the next offset (reference player)."""
+    page_mask, flags = data[offset], data[offset + 1]
+    offset += 2
+    for page in range(pages):
+        if not page_mask & (1 << page):
+            continue
+        start, end = data[offset], data[offset + 1]
+        offset += 2
+        count = end - start + 1
+        # Expand the PackBits data of this span
+        out = bytearray()
+        pos = offset
+        while len(out) < count:
+            control = data[pos]
+            pos += 1
+            if control < 128:
+                out += data[pos:pos + control + 1]
+                pos += control + 1
+            elif control > 128:
+                out += bytes([data[pos]]) * (257 - control)
+                pos += 1
+        offset = pos
+        base = page * width + start
+        for i in range(count):
+            frame[base + i] = out[i] if flags & FRAME_KEY else frame[base + i] ^ out[i]
+    return offset
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Encode frames into an SSD1306 delta animation stream")
+    parser.add_argument("images", nargs="+", help="frames in display order (.png, .pgm)")
+    parser.add_argument("-s", "--sheet", type=int, help="split each input into frames of this height (stacked vertically)")
+    parser.add_argument("-n", "--name", help="C identifier of the generated animation (default: first file name)")
+    parser.add_argument("-d", "--dither", choices=("threshold", "bayer", "fs"), default="bayer",
+                        help="1-bit conversion (default: bayer, which keeps still areas stable between frames)")
+    parser.add_argument("-t", "--threshold", type=int, default=128, help="threshold level 0-255 (default: 128)")
+    parser.add_argument("-i", "--invert", action="store_true", help="light the dark pixels")
+    parser.add_argument("--background", type=int, default=0, help="luminance behind transparent PNG pixels (default: 0)")
+    parser.add_argument("-f", "--fps", type=float, default=20, help="playback rate stored in the stream (default: 20)")
+    parser.add_argument("-l", "--loop", action="store_true", help="append a frame that leads back to frame 0 and loop")
+    parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count(), help="worker processes (default: all cores)")
+    parser.add_argument("-o", "--output", help="output header (default: stdout unless --binary is given)")
+    parser.add_argument("-b", "--binary", help="also write the stream as a binary file for the host player")
+    args = parser.parse_args()
+
+    # Load the frames as luminance rows
+    frames = []
+    for path in args.images:
+        width, height, pixels = load(path, args.background)
+        if args.sheet:
+            for top in range(0, height - args.sheet + 1, args.sheet):
+                frames.append((width, args.sheet, pixels[top:top + args.sheet]))
+        else:
+            frames.append((width, height, pixels))
+    if not frames:
+        sys.exit("no frames")
+    width, height = frames[0][0], frames[0][1]
+    if any(f[0] != width or f[1] != height for f in frames):
+        sys.exit("all frames must have the same size")
+    if width > 128 or height > 64:
+        sys.exit("%dx%d frames exceed the 128x64 panel" % (width, height))
+    pages = (height + 7) // 8
+
+    with multiprocessing.Pool(max(1, args.jobs)) as pool:
+        bitmaps = pool.map(convert_frame, [(w, h, p, args) for w, h, p in frames], chunksize=4)
+        jobs = [(None, bitmaps[0], width, pages)]
+        jobs += [(bitmaps[i - 1], bitmaps[i], width, pages) for i in range(1, len(bitmaps))]
+        loop = args.loop and len(bitmaps) > 1
+        if loop:
+            jobs.append((bitmaps[-1], bitmaps[0], width, pages))
+        encoded = pool.map(encode_frame, jobs, chunksize=4)
+
+    data = b"".join(encoded)
+    loop_offset = len(encoded[0]) if loop else 0
+    interval = max(1, int(round(1000 / args.fps)))
+
+    # Play the stream back with the reference decoder
+    shown = bytearray(width * pages)
+    offset = 0
+    for i, expected in enumerate(bitmaps + ([bitmaps[0]] if loop else [])):
+        offset = decode_frame(data, offset, shown, width, pages)
+        assert bytes(shown) == expected, "frame %d does not round-trip" % i
+    assert offset == len(data)
+
+    name = args.name or os.path.splitext(os.path.basename(args.images[0]))[0].replace("-", "_")
+    raw_size = width * pages
+    deltas = encoded[1:]
+    sys.stderr.write("%s: %dx%d, %d frames%s, %d bytes (raw %d), key frame %d bytes, %.1f bytes/frame on average\n"
+                     % (name, width, height, len(bitmaps), " + loop" if loop else "", len(data),
+                        raw_size * len(bitmaps), len(encoded[0]),
+                        sum(len(d) for d in deltas) / max(1, len(deltas))))
+
+    if args.binary:
+        with open(args.binary, "wb") as f:
+            f.write(BINARY_MAGIC)
+            f.write(struct.pack("<BBHHII", width, height, len(encoded), interval, loop_offset, len(data)))
+            f.write(data)
+
+    if args.output or not args.binary:
+        guard = "_ANIM_%s_H" % name.upper()
+        out = []
+        out.append("// Generated by tools/animc.py from %s -- do not edit" % os.path.basename(args.images[0]))
+        out.append("// %dx%d, %d frames%s, %d bytes (raw %d)"
+                   % (width, height, len(bitmaps), " + loop" if loop else "", len(data), raw_size * len(bitmaps)))
+        out.append("#ifndef %s" % guard)
+        out.append("#define %s" % guard)
+        out.append("")
+        out.append("static const uint8_t %s_data[] = {" % name)
+        for i in range(0, len(data), 16):
+            out.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+        out.append("static const SSD1306_Animation %s = {" % name)
+        out.append("    %s_data, %d, %d, %d, %d, %d, %d, // data, size, loop_offset, frame_count, frame_interval, width, height"
+                   % (name, len(data), loop_offset, len(encoded), interval, width, height))
+        out.append("};")
+        out.append("")
+        out.append("#endif")
+        text = "\n".join(out) + "\n"
+
+        if args.output:
+            with open(args.output, "w", encoding="utf-8") as f:
+                f.write(text)
+        else:
+            sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
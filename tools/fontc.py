@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+"""SSD1306 font compiler.
+
+Converts a BDF bitmap font into the page-major C arrays used by
+SSD1306_DrawStringFont(). TrueType/OpenType fonts can be rasterized to BDF
+first, e.g. ``otf2bdf -p 12 -r 72 font.ttf > font12.bdf``.
+
+Usage:
+    python3 tools/fontc.py font12.bdf -n font12 -r 0x20-0x7E,0x391-0x3C9 -o include/font12.h
+
+Large character sets (kana/kanji) that do not fit in MCU flash can be written
+as a binary glyph image for external SPI flash, read through the RAM glyph
+cache (include/ssd1306_glyph_cache.h):
+    python3 tools/fontc.py k16.bdf -f bin -r 0x20-0x7E,0x3000-0x30FF,0x4E00-0x9FFF -o k16.bin
+
+Only the Python 3 standard library is required.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+
+def parse_ranges(text):
+    ranges = []
+    for part in text.split(","):
+        part = part.strip()
+        if not part:
+            continue
+        if "-" in part:
+            lo, hi = part.split("-", 1)
+            ranges.append((int(lo, 0), int(hi, 0)))
+        else:
+            ranges.append((int(part, 0), int(part, 0)))
+    return ranges
+
+
+def in_ranges(codepoint, ranges):
+    return any(lo <= codepoint <= hi for lo, hi in ranges)
+
+
+def parse_bdf(path):
+    """Return (ascent, descent, glyphs) where glyphs maps code point to a dict."""
+    ascent = descent = None
+    bbox = None
+    glyphs = {}
+    glyph = None
+    bitmap_rows = None
+
+    with open(path, encoding="latin-1") as f:
+        for raw in f:
+            line = raw.strip()
+            if not line:
+                continue
+            key, _, rest = line.partition(" ")
+            if bitmap_rows is not None:
+                if key == "ENDCHAR":
+                    glyph["rows"] = bitmap_rows
+                    if glyph.get("encoding", -1) >= 0:
+                        glyphs[glyph["encoding"]] = glyph
+                    glyph = None
+                    bitmap_rows = None
+                else:
+                    bitmap_rows.append(int(line, 16) if line else 0)
+                continue
+            if key == "FONT_ASCENT":
+                ascent = int(rest)
+            elif key == "FONT_DESCENT":
+                descent = int(rest)
+            elif key == "FONTBOUNDINGBOX":
+                bbox = [int(v) for v in rest.split()]
+            elif key == "STARTCHAR":
+                glyph = {"name": rest}
+            elif key == "ENCODING" and glyph is not None:
+                glyph["encoding"] = int(rest.split()[0])
+            elif key == "DWIDTH" and glyph is not None:
+                glyph["dwidth"] = int(rest.split()[0])
+            elif key == "BBX" and glyph is not None:
+                glyph["bbx"] = [int(v) for v in rest.split()]
+            elif key == "BITMAP" and glyph is not None:
+                bitmap_rows = []
+
+    if ascent is None or descent is None:
+        if bbox is None:
+            raise ValueError("%s: missing FONT_ASCENT/FONT_DESCENT and FONTBOUNDINGBOX" % path)
+        ascent = bbox[1] + bbox[3]
+        descent = -bbox[3]
+    return ascent, descent, glyphs
+
+
+def rasterize(glyph, ascent, height):
+    """Place a BDF glyph in a cell of the font height; return (width, pixel rows)."""
+    w, h, xoff, yoff = glyph["bbx"]
+    xoff = max(xoff, 0)
+    width = xoff + w
+    row_bytes = (w + 7) // 8
+    pixels = [[0] * width for _ in range(height)]
+    top = ascent - (yoff + h)  # Cell row of the first bitmap row
+
+    for r, bits in enumerate(glyph["rows"]):
+        y = top + r
+        if y < 0 or y >= height:
+            continue  # Clip to the cell
+        for c in range(w):
+            if bits & (1 << (row_bytes * 8 - 1 - c)):
+                pixels[y][xoff + c] = 1
+    return width, pixels
+
+
+def to_page_major(width, pixels, height):
+    data = []
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and pixels[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return data
+
+
+def describe(codepoint):
+    if 32 < codepoint < 127 and chr(codepoint) not in "\\'":
+        return "U+%04X '%s'" % (codepoint, chr(codepoint))
+    if codepoint >= 0xA0:
+        return "U+%04X %s" % (codepoint, chr(codepoint))
+    return "U+%04X" % codepoint
+
+
+def write_image(args, entries, bitmaps, height, ascent, default_advance):
+    """Write the "SGF1" glyph image read by ssd1306_glyph_cache.c."""
+    header_size = 12
+    entry_size = 8
+    data_start = header_size + entry_size * len(entries)
+
+    image = bytearray(b"SGF1")
+    image += struct.pack("<HBBBBH", len(entries), height, ascent, height + args.line_gap, default_advance, 0)
+    for codepoint, offset, width, advance in entries:
+        image += struct.pack("<HBBI", codepoint, width, advance, data_start + offset)
+    image += bytes(bitmaps)
+
+    if not args.output:
+        sys.exit("binary output requires -o")
+    with open(args.output, "wb") as f:
+        f.write(image)
+    max_bytes = max(width * ((height + 7) // 8) for _, _, width, _ in entries)
+    sys.stderr.write("%d glyphs, %d bytes image, largest glyph %d bytes (SSD1306_GLYPH_CACHE_MAX_BYTES)\n"
+                     % (len(entries), len(image), max_bytes))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compile a BDF font into SSD1306 page-major C arrays")
+    parser.add_argument("bdf", help="input BDF font")
+    parser.add_argument("-n", "--name", help="C identifier of the generated font (default: file name)")
+    parser.add_argument("-r", "--ranges", default="0x20-0x7E", help="code point ranges to include (default: 0x20-0x7E)")
+    parser.add_argument("-s", "--spacing", type=int, default=0, help="extra pixels added to every advance")
+    parser.add_argument("-g", "--line-gap", type=int, default=1, help="pixels between lines (default: 1)")
+    parser.add_argument("-f", "--format", choices=("header", "bin"), default="header",
+                        help="C header for on-chip flash or binary glyph image for external storage")
+    parser.add_argument("-o", "--output", help="output file (default: stdout)")
+    args = parser.parse_args()
+
+    name = args.name or os.path.splitext(os.path.basename(args.bdf))[0].replace("-", "_")
+    ranges = parse_ranges(args.ranges)
+    ascent, descent, glyphs = parse_bdf(args.bdf)
+    height = ascent + descent
+    if height > 64:
+        sys.exit("font height %d exceeds the 64 pixel panel" % height)
+
+    bitmaps = []
+    entries = []
+    for codepoint in sorted(glyphs):
+        if codepoint > 0xFFFF or not in_ranges(codepoint, ranges):
+            continue
+        glyph = glyphs[codepoint]
+        width, pixels = rasterize(glyph, ascent, height)
+        advance = glyph.get("dwidth", width) + args.spacing
+        if width > 255 or advance > 255:
+            sys.exit("%s: glyph too wide" % describe(codepoint))
+        entries.append((codepoint, len(bitmaps), width, advance))
+        bitmaps.extend(to_page_major(width, pixels, height))
+
+    if not entries:
+        sys.exit("no glyphs in the requested ranges")
+    space = next((e for e in entries if e[0] == 0x20), None)
+    default_advance = space[3] if space else max(1, height // 2)
+
+    if args.format == "bin":
+        write_image(args, entries, bitmaps, height, ascent, default_advance)
+        return
+    if len(bitmaps) > 0xFFFF:
+        sys.exit("bitmap data %d bytes exceeds the 16-bit glyph offset" % len(bitmaps))
+    guard = "_FONT_%s_H" % name.upper()
+
+    out = []
+    out.append("// Generated by tools/fontc.py from %s -- do not edit" % os.path.basename(args.bdf))
+    out.append("// %d glyphs, %d pixels high, %d bitmap bytes" % (len(entries), height, len(bitmaps)))
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append("static const uint8_t %s_bitmaps[] = {" % name)
+    for i, (codepoint, offset, width, _) in enumerate(entries):
+        end = entries[i + 1][1] if i + 1 < len(entries) else len(bitmaps)
+        data = ", ".join("0x%02X" % b for b in bitmaps[offset:end])
+        out.append("    %s // %s" % (data + "," if data else "", describe(codepoint)))
+    out.append("};")
+    out.append("")
+    out.append("static const SSD1306_FontGlyph %s_glyphs[] = {" % name)
+    for codepoint, offset, width, advance in entries:
+        out.append("    {0x%04X, %d, %d, %d}, // %s" % (codepoint, offset, width, advance, describe(codepoint)))
+    out.append("};")
+    out.append("")
+    out.append("static const SSD1306_Font %s = {" % name)
+    out.append("    %s_bitmaps, %s_glyphs, %d, // bitmaps, glyphs, glyph_count" % (name, name, len(entries)))
+    out.append("    %d, %d, %d, %d,            // height, baseline, line_height, default_advance"
+               % (height, ascent, height + args.line_gap, default_advance))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    text = "\n".join(out) + "\n"
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    sys.stderr.write("%s: %d glyphs, %d bytes bitmap + %d bytes index\n"
+                     % (name, len(entries), len(bitmaps), len(entries) * 6))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,342 @@
+#!/usr/bin/env python3
+"""SSD1306 image converter.
+
+Converts a PNG or PGM image into the page-major layout of the frame buffer and
+writes a C header with an SSD1306_Image for SSD1306_DrawImage(). Grayscale and
+color images are reduced to 1 bit per pixel by thresholding, ordered (Bayer 8x8)
+dithering or Floyd-Steinberg error diffusion. The data can be PackBits
+run-length coded; the device decodes it while blitting, one page row at a time.
+
+Usage:
+    python3 tools/imgc.py logo.png -d fs -c auto -o include/image_logo.h
+    python3 tools/imgc.py photo.pgm -d bayer --invert -n photo -p preview.pgm
+
+Only the Python 3 standard library is required (PNG is decoded with zlib).
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+IMAGE_RAW = 0
+IMAGE_RLE = 1
+
+BAYER8 = [
+    [0, 32, 8, 40, 2, 34, 10, 42],
+    [48, 16, 56, 24, 50, 18, 58, 26],
+    [12, 44, 4, 36, 14, 46, 6, 38],
+    [60, 28, 52, 20, 62, 30, 54, 22],
+    [3, 35, 11, 43, 1, 33, 9, 41],
+    [51, 19, 59, 27, 49, 17, 57, 25],
+    [15, 47, 7, 39, 13, 45, 5, 37],
+    [63, 31, 55, 23, 61, 29, 53, 21],
+]
+
+
+def read_pgm(path):
+    """Return (width, height, rows of 0-255 luminance) for a P2 or P5 file."""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    tokens = []
+    pos = 0
+    while len(tokens) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            while data[pos:pos + 1] not in (b"\n", b""):
+                pos += 1
+            continue
+        start = pos
+        while pos < len(data) and not data[pos:pos + 1].isspace():
+            pos += 1
+        tokens.append(data[start:pos])
+    magic, width, height, maxval = tokens[0], int(tokens[1]), int(tokens[2]), int(tokens[3])
+
+    if magic == b"P5":
+        pos += 1  # Single whitespace before the raster
+        size = 2 if maxval > 255 else 1
+        raster = data[pos:pos + width * height * size]
+        if size == 2:
+            values = [(raster[i] << 8) | raster[i + 1] for i in range(0, len(raster), 2)]
+        else:
+            values = list(raster)
+    elif magic == b"P2":
+        values = [int(v) for v in data[pos:].split()[:width * height]]
+    else:
+        raise ValueError("%s: not a PGM file (P2/P5)" % path)
+    if len(values) < width * height:
+        raise ValueError("%s: truncated raster" % path)
+
+    scale = 255.0 / maxval
+    return width, height, [[int(values[y * width + x] * scale + 0.5) for x in range(width)] for y in range(height)]
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path, background):
+    """Return (width, height, rows of 0-255 luminance); alpha is composited over background."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG file" % path)
+
+    pos = 8
+    idat = b""
+    palette = None
+    transparency = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            transparency = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNG is not supported" % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    bits_per_pixel = channels * depth
+    stride = (width * bits_per_pixel + 7) // 8
+    bpp = max(1, bits_per_pixel // 8)  # Filter distance in bytes
+    raw = zlib.decompress(idat)
+
+    # Undo the per-row filters
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if filter_type == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif filter_type == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif filter_type == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif filter_type == 4:
+                line[i] = (line[i] + paeth(a, b, c)) & 0xFF
+        rows.append(line)
+        prev = line
+
+    def samples(line):
+        if depth == 8:
+            return list(line)
+        if depth == 16:
+            return [line[i] for i in range(0, len(line), 2)]  # High byte
+        per_byte = 8 // depth
+        mask = (1 << depth) - 1
+        out = []
+        for byte in line:
+            for k in range(per_byte):
+                out.append((byte >> (8 - depth * (k + 1))) & mask)
+        return out
+
+    max_sample = (1 << depth) - 1
+    pixels = []
+    for line in rows:
+        s = samples(line)
+        out = []
+        for x in range(width):
+            if color_type == 3:
+                index = s[x]
+                r, g, b = palette[index]
+                alpha = transparency[index] if transparency and index < len(transparency) else 255
+            else:
+                px = s[x * channels:(x + 1) * channels]
+                px = [v * 255 // max_sample for v in px] if depth < 8 else px
+                if color_type in (0, 4):
+                    r = g = b = px[0]
+                else:
+                    r, g, b = px[0], px[1], px[2]
+                alpha = px[-1] if color_type in (4, 6) else 255
+            lum = (299 * r + 587 * g + 114 * b) // 1000
+            out.append((lum * alpha + background * (255 - alpha)) // 255)
+        pixels.append(out)
+    return width, height, pixels
+
+
+def dither(pixels, width, height, method, threshold):
+    """Return rows of 0/1 (1 = lit)."""
+    if method == "threshold":
+        return [[1 if pixels[y][x] >= threshold else 0 for x in range(width)] for y in range(height)]
+    if method == "bayer":
+        return [[1 if pixels[y][x] * 64 > (BAYER8[y & 7][x & 7] + 0.5) * 255 else 0 for x in range(width)]
+                for y in range(height)]
+
+    # Floyd-Steinberg, serpentine scan
+    work = [[float(v) for v in row] for row in pixels]
+    out = [[0] * width for _ in range(height)]
+    for y in range(height):
+        forward = (y % 2 == 0)
+        xs = range(width) if forward else range(width - 1, -1, -1)
+        step = 1 if forward else -1
+        for x in xs:
+            old = work[y][x]
+            new = 255.0 if old >= threshold else 0.0
+            out[y][x] = 1 if new else 0
+            err = old - new
+            if 0 <= x + step < width:
+                work[y][x + step] += err * 7 / 16
+            if y + 1 < height:
+                if 0 <= x - step < width:
+                    work[y + 1][x - step] += err * 3 / 16
+                work[y + 1][x] += err * 5 / 16
+                if 0 <= x + step < width:
+                    work[y + 1][x + step] += err * 1 / 16
+    return out
+
+
+def to_page_major(width, height, bits):
+    data = bytearray()
+    for page in range((height + 7) // 8):
+        for x in range(width):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < height and bits[y][x]:
+                    byte |= 1 << bit
+            data.append(byte)
+    return data
+
+
+def packbits(data):
+    """PackBits: 0-127 = n+1 literal bytes follow, 129-255 = next byte repeated 257-n times."""
+    out = bytearray()
+    literal = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3 or (run == 2 and not literal):
+            if literal:
+                out.append(len(literal) - 1)
+                out += literal
+                literal = bytearray()
+            out.append(257 - run)
+            out.append(data[i])
+            i += run
+            continue
+        literal.append(data[i])
+        i += 1
+        if len(literal) == 128:
+            out.append(127)
+            out += literal
+            literal = bytearray()
+    if literal:
+        out.append(len(literal) - 1)
+        out += literal
+    return out
+
+
+def unpackbits(data, size):
+    out = bytearray()
+    i = 0
+    while len(out) < size:
+        control = data[i]
+        i += 1
+        if control < 128:
+            out += data[i:i + control + 1]
+            i += control + 1
+        elif control > 128:
+            out += bytes([data[i]]) * (257 - control)
+            i += 1
+    return bytes(out[:size])
+
+
+def write_preview(path, width, height, bits):
+    with open(path, "wb") as f:
+        f.write(b"P5\n%d %d\n255\n" % (width, height))
+        f.write(bytes(255 if bits[y][x] else 0 for y in range(height) for x in range(width)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a PNG/PGM image into an SSD1306 page-major C header")
+    parser.add_argument("image", help="input image (.png, .pgm)")
+    parser.add_argument("-n", "--name", help="C identifier of the generated image (default: file name)")
+    parser.add_argument("-d", "--dither", choices=("threshold", "bayer", "fs"), default="fs",
+                        help="1-bit conversion (default: fs = Floyd-Steinberg)")
+    parser.add_argument("-t", "--threshold", type=int, default=128, help="threshold level 0-255 (default: 128)")
+    parser.add_argument("-i", "--invert", action="store_true", help="light the dark pixels")
+    parser.add_argument("-b", "--background", type=int, default=0,
+                        help="luminance behind transparent PNG pixels (default: 0)")
+    parser.add_argument("-c", "--compress", choices=("none", "rle", "auto"), default="auto",
+                        help="data encoding; auto keeps RLE only when it is smaller (default: auto)")
+    parser.add_argument("-p", "--preview", help="also write the 1-bit result as a PGM file")
+    parser.add_argument("-o", "--output", help="output header (default: stdout)")
+    args = parser.parse_args()
+
+    name = args.name or os.path.splitext(os.path.basename(args.image))[0].replace("-", "_")
+    if args.image.lower().endswith(".png"):
+        width, height, pixels = read_png(args.image, args.background)
+    else:
+        width, height, pixels = read_pgm(args.image)
+    if width > 255 or height > 255:
+        sys.exit("%dx%d image exceeds the 255 pixel limit of SSD1306_Image" % (width, height))
+    if args.invert:
+        pixels = [[255 - v for v in row] for row in pixels]
+
+    bits = dither(pixels, width, height, args.dither, args.threshold)
+    raw = to_page_major(width, height, bits)
+    rle = packbits(raw)
+    assert unpackbits(rle, len(raw)) == bytes(raw)
+
+    use_rle = args.compress == "rle" or (args.compress == "auto" and len(rle) < len(raw))
+    data = rle if use_rle else raw
+    if len(data) > 0xFFFF:
+        sys.exit("image data %d bytes exceeds the 16-bit size field" % len(data))
+    if args.preview:
+        write_preview(args.preview, width, height, bits)
+
+    guard = "_IMAGE_%s_H" % name.upper()
+    dither_name = {"threshold": "threshold %d" % args.threshold, "bayer": "Bayer 8x8", "fs": "Floyd-Steinberg"}
+    out = []
+    out.append("// Generated by tools/imgc.py from %s -- do not edit" % os.path.basename(args.image))
+    out.append("// %dx%d, %s, %d bytes raw, %d bytes RLE (%d%%)"
+               % (width, height, dither_name[args.dither], len(raw), len(rle), len(rle) * 100 // max(1, len(raw))))
+    out.append("#ifndef %s" % guard)
+    out.append("#define %s" % guard)
+    out.append("")
+    out.append("static const uint8_t %s_data[] = {" % name)
+    for i in range(0, len(data), 16):
+        out.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const SSD1306_Image %s = {" % name)
+    out.append("    %s_data, %d, %d, %d, %s, // data, size, width, height, encoding"
+               % (name, len(data), width, height, "SSD1306_IMAGE_RLE" if use_rle else "SSD1306_IMAGE_RAW"))
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    text = "\n".join(out) + "\n"
+
+    if args.output:
+        with open(args.output, "w", encoding="utf-8") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    sys.stderr.write("%s: %dx%d, flash %d bytes (%s; raw %d, RLE %d)\n"
+                     % (name, width, height, len(data), "RLE" if use_rle else "raw", len(raw), len(rle)))
+
+
+if __name__ == "__main__":
+    main()